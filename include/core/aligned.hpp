@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+// Allocator con alineación fija (línea de cache) para los framebuffers:
+// las filas de tiles arrancan en frontera de 64 B y los stores
+// non-temporal escriben líneas completas.
+template <class T, std::size_t Align>
+struct AlignedAllocator {
+  using value_type = T;
+  template <class U> struct rebind { using other = AlignedAllocator<U, Align>; };
+
+  AlignedAllocator() = default;
+  template <class U> AlignedAllocator(const AlignedAllocator<U, Align>&) {}
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Align)));
+  }
+  void deallocate(T* p, std::size_t) { ::operator delete(p, std::align_val_t(Align)); }
+
+  template <class U> bool operator==(const AlignedAllocator<U, Align>&) const { return true; }
+  template <class U> bool operator!=(const AlignedAllocator<U, Align>&) const { return false; }
+};
+
+// Framebuffer ARGB8888 alineado a 64 B
+using PixelBuffer = std::vector<uint32_t, AlignedAllocator<uint32_t, 64>>;
@@ -9,8 +9,18 @@ struct AppConfig {
   float lacunarity  = 2.0f;
   float persistence = 0.5f;
   float zspeed      = 0.15f;
+  std::string noise = "value"; // value|gradient|volume
+  int   noise_vol = 64;          // lado del volumen precalculado (32|64|128)
+  std::string noise_cache;       // dir. de cache mmap del volumen ("" = no persistir)
   unsigned int seed = 0;
+  bool  deterministic = false;  // paleta sólo por seed + t = frame/60 (reproducible)
   bool  vsync   = false;
+  bool  stars   = true;         // estrellas con parpadeo
+  float drift   = 1.0f;         // intensidad del giro/tono animado (0 = fijo)
+
+  // Energía: límite de FPS y política de espera del equipo OpenMP
+  float fps_cap = 0.0f;                // 0 = sin límite
+  std::string wait_policy = "default"; // active|passive|default
 
   // UI / título / paleta
   bool  show_fps = true;      // mostrar FPS en pantalla/console
@@ -20,9 +30,20 @@ struct AppConfig {
   // OpenMP
   std::string omp_schedule = "static"; // static|dynamic|guided|auto
   int   omp_chunk = 32;                // tamaño de bloque / tile
+  int   tile_w = 0, tile_h = 0;        // tile explícito (0 = derivado de omp_chunk)
+  int   threads = 0;                   // nº de hilos (0 = default de OpenMP)
+
+  // Autotuner (barrido headless de tile/schedule/chunk/hilos/escala)
+  bool  autotune = false;
+  float autotune_quality = 1.0f;       // render_scale mínimo aceptable
+  std::string autotune_cache;          // "" = $XDG_CACHE_HOME/nebula-autotune.txt
 
   // Render a baja resolución + upscale (para subir FPS)
   float render_scale = 1.0f;           // 0.3..1.0
+  bool  progressive  = true;           // arranque 1/8 -> 1/4 -> 1/2 -> completo
+
+  // Salida del framebuffer con stores non-temporal (no ensucian la cache)
+  std::string stream = "auto";         // on|off|auto (auto: frame > LLC)
 
   // Normaliza / corrige argumentos
   void clamp_to_valid_ranges();
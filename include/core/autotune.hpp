@@ -0,0 +1,27 @@
+#pragma once
+#include "app_config.hpp"
+#include <string>
+
+// Mejor configuración encontrada por el autotuner para (CPU, núcleos, resolución)
+struct TuneResult {
+  int   tile_w = 32, tile_h = 32;
+  std::string schedule = "static";
+  int   chunk = 32;
+  int   threads = 0;
+  float scale = 1.0f;
+  double ms = 0.0;     // tiempo medido por frame (banda de muestra)
+};
+
+// Clave de cache: "<modelo CPU>|<núcleos>|<W>x<H>"
+std::string autotune_key(const AppConfig& cfg);
+
+// Barrido headless (sin SDL) por descenso de coordenadas:
+// tile -> schedule/chunk -> hilos -> render_scale (>= autotune_quality)
+TuneResult autotune_run(const AppConfig& cfg);
+
+// Lee/escribe la entrada de cache para la clave de cfg (false si no existe)
+bool autotune_load(const AppConfig& cfg, TuneResult& out);
+void autotune_save(const AppConfig& cfg, const TuneResult& r);
+
+// Vuelca el resultado sobre la config
+void autotune_apply(AppConfig& cfg, const TuneResult& r);
@@ -1,4 +1,5 @@
 #pragma once
 #include "app_config.hpp"
 
-AppConfig parse_cli(int argc, char** argv);
\ No newline at end of file
+AppConfig parse_cli(int argc, char** argv);
+AppConfig parse_cli(int argc, char** argv, const AppConfig& defaults);
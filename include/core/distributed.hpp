@@ -0,0 +1,40 @@
+#pragma once
+#include "app_config.hpp"
+#include <cstdint>
+#include <functional>
+
+// =====================================================
+//  Render offline distribuido: coordinador + N procesos worker
+//  - Los workers son procesos locales (fork + socketpair AF_UNIX); cada
+//    uno construye su NebulaField desde la config, como lo haría otro host.
+//  - El coordinador reparte trabajos (frame completo o banda de filas) y
+//    recibe las filas ARGB crudas de vuelta.
+//  - Los frames se entregan en orden; como mucho `max_buffered` frames
+//    están a medio armar a la vez (memoria acotada).
+//  Protocolo (mensajes de tamaño fijo, binario nativo: sólo mismo host):
+//    coord -> worker: Job  {frame, y0, y1}   (frame < 0: terminar)
+//    worker -> coord: Rows {frame, y0, y1} + (y1-y0) * W * 4 bytes
+// =====================================================
+struct DistOptions {
+  int   workers = 2;
+  int   frames = 60;
+  float fps = 60.f;          // t = frame / fps
+  bool  bands = false;       // false: un trabajo por frame; true: bandas de filas
+  int   band_rows = 64;
+  int   max_buffered = 0;    // frames en vuelo (reorder buffer); 0 = lo justo
+                             // para workers*depth trabajos pendientes
+  int   depth = 2;           // trabajos pendientes por worker (pipelining)
+};
+
+struct DistResult {
+  bool   ok = false;
+  long   frames = 0;
+  double seconds = 0.0;
+};
+
+// Recibe cada frame completo (W x H ARGB8888), en orden de índice
+using FrameSink = std::function<void(int frame, const uint32_t* pixels)>;
+
+// Renderiza opt.frames frames de `cfg` (se fuerza modo determinista para
+// que todos los workers usen la misma paleta). Sólo Linux/Unix.
+DistResult dist_render(const AppConfig& cfg, const DistOptions& opt, const FrameSink& sink);
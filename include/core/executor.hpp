@@ -0,0 +1,71 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// =====================================================
+//  Ejecutores para render_frame: reparten fn(i), i en [0,n),
+//  sin imponer de dónde salen los hilos. parallel_for vuelve
+//  cuando todos los índices terminaron.
+// =====================================================
+class Executor {
+public:
+  virtual ~Executor() = default;
+  virtual void parallel_for(int n, const std::function<void(int)>& fn) = 0;
+};
+
+// Todo en el hilo que llama
+class SerialExecutor : public Executor {
+public:
+  void parallel_for(int n, const std::function<void(int)>& fn) override;
+};
+
+// Equipo OpenMP con schedule(runtime) (respeta --schedule/--chunk).
+// threads = 0 -> omp_get_max_threads(). Sin OpenMP se comporta como serial.
+class OmpExecutor : public Executor {
+public:
+  explicit OmpExecutor(int threads = 0) : threads_(threads) {}
+  void parallel_for(int n, const std::function<void(int)>& fn) override;
+private:
+  int threads_;
+};
+
+// Pool propio de std::thread (threads - 1 workers + el hilo que llama).
+// Los índices se reparten dinámicamente con un contador compartido.
+class ThreadPoolExecutor : public Executor {
+public:
+  explicit ThreadPoolExecutor(int threads = 0);   // 0 -> hardware_concurrency
+  ~ThreadPoolExecutor() override;
+  ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+  ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+  void parallel_for(int n, const std::function<void(int)>& fn) override;
+  int size() const { return (int)workers_.size() + 1; }
+private:
+  void worker_loop();
+  void drain();                 // consume índices del trabajo actual
+
+  std::vector<std::thread> workers_;
+  std::mutex m_;
+  std::condition_variable cv_work_, cv_done_;
+  const std::function<void(int)>* fn_ = nullptr;
+  int  n_ = 0, next_ = 0, pending_ = 0, busy_ = 0;
+  long gen_ = 0;
+  bool stop_ = false;
+};
+
+// Pool del host: `submit` encola una tarea en su propio pool.
+// Se envían hasta `concurrency` tareas que consumen índices; el hilo que
+// llama también trabaja, así no se bloquea aunque el pool esté saturado
+// (o si se llama desde uno de sus workers).
+class TaskExecutor : public Executor {
+public:
+  using Submit = std::function<void(std::function<void()>)>;
+  TaskExecutor(Submit submit, int concurrency)
+    : submit_(std::move(submit)), concurrency_(concurrency) {}
+  void parallel_for(int n, const std::function<void(int)>& fn) override;
+private:
+  Submit submit_;
+  int concurrency_;
+};
@@ -1,6 +1,8 @@
 #pragma once
 #include "app_config.hpp"
+#include "noise_volume.hpp"
 #include <cstdint>
+#include <memory>
 #include <string>
 
 class NebulaField {
@@ -10,11 +12,19 @@ public:
   // Genera el píxel ARGB8888 para (x,y) en tiempo t (segundos)
   uint32_t sample_pixel(int x, int y, float t) const;
 
+  // true si la imagen no depende de t (zspeed=0, drift=0, sin estrellas):
+  // basta con renderizar una vez
+  bool is_static() const;
+
 private:
+  friend struct NebulaFieldProbe; // acceso para bench (core/internal.hpp)
+
   AppConfig cfg_;
     // Colores extremos de la paleta aleatoria (derivados de --seed)
   uint8_t baseR1, baseG1, baseB1;
   uint8_t baseR2, baseG2, baseB2;
+  bool gradient_ = false;   // --noise gradient (warp por derivadas)
+  std::shared_ptr<const NoiseVolume> vol_;  // --noise volume (lattice precalculado)
 
 
   // Helpers
@@ -24,10 +34,18 @@ private:
 
   // Ruido / fBm
   uint32_t hash_u32(uint32_t x) const;
+  uint32_t lattice_hash(int xi, int yi, int zi) const;         // hash del nodo (32 bits)
+  uint16_t lattice_u16(int xi, int yi, int zi) const;          // valor del nodo
   float noise3(float x, float y, float z) const;               // [0,1]
+  float vnoise3(float x, float y, float z) const;              // [0,1] desde vol_
+  struct NoiseD { float v, dx, dy, dz; };                      // valor + derivadas parciales
+  NoiseD gnoise3(float x, float y, float z) const;             // gradiente, v ~[-1,1]
   float fbm(float x, float y, float z, int octaves) const;     // ~[-1,1]
   float rfbm(float x, float y, float z, int octaves) const;    // [0,1] filamentos (ridged)
 
+  // Paleta aleatoria por seed + saturación + rotación de tono
+  void color_stage(float shade, float t, uint8_t& r, uint8_t& g, uint8_t& b) const;
+
   // Paletas
   void palette_nebula(float v, uint8_t& r, uint8_t& g, uint8_t& b) const;
   void palette_inferno(float v, uint8_t& r, uint8_t& g, uint8_t& b) const;
@@ -3,7 +3,7 @@
 
 class FPSCounter {
 public:
-  void tick();
+  bool tick(); // true si se recalculó el FPS (cada 500 ms)
   double fps() const { return fps_; }
 private:
   int frames_ = 0;
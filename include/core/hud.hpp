@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// =====================================================
+//  Mini HUD: texto 5x7 sobre una caja semitransparente
+//  (sin SDL_ttf; fuente bitmap mínima para mostrar FPS, tiempos, etc.)
+//  El HUD se rasteriza en un overlay ARGB premultiplicado que sólo se
+//  reconstruye cuando cambia el texto; cada frame sólo se compone.
+// =====================================================
+namespace hud {
+
+struct Glyph { uint8_t rows[7]; };
+
+// Glyph 5x7 del caracter (minúsculas -> mayúsculas; desconocidos -> espacio)
+const Glyph* get(char c);
+
+// "src over dst" con src ARGB premultiplicado y dst opaco (enteros)
+uint32_t over_premul(uint32_t dst, uint32_t src);
+
+// -----------------------------------------------------
+// Overlay: capa ARGB premultiplicada con el HUD ya rasterizado.
+// - Atlas: cada glyph pre-rasterizado a escala `s` con su sombra (1px),
+//   celda de (5s+1)x(7s+1); se construye una vez por escala.
+// - update(): reconstruye la capa sólo si cambió el texto (FPS cada 500 ms).
+// - composite(): mezcla entera (SSE2 si está disponible) sólo en su bbox,
+//   sobre un frame W x H con filas separadas `stride` bytes.
+// - blend_span(): lo mismo para un tramo de una fila (columnas [fx0,fx1)
+//   de la fila fy del frame, d[0] = columna fx0). Es lo que usa
+//   render_frame para mezclar el HUD en su buffer local antes del store,
+//   sin releer el destino (textura write-only).
+// -----------------------------------------------------
+class Overlay {
+public:
+  bool update(const std::string& text, int s);   // true si se reconstruyó
+  void composite(uint32_t* pix, size_t stride, int W, int H, int x, int y) const;
+  void blend_span(uint32_t* d, int fx0, int fx1, int fy, int x, int y) const;
+  int width() const { return w_; }
+  int height() const { return h_; }
+
+private:
+  std::string text_;
+  int scale_=0, cw_=0, ch_=0, w_=0, h_=0;
+  std::vector<uint32_t> atlas_; // 128 celdas (ASCII) de cw_ x ch_
+  std::vector<uint32_t> px_;    // capa w_ x h_
+
+  static int glyph_index(char c){ return (unsigned char)c<128 ? (unsigned char)c : ' '; }
+  void build_atlas(int s);
+};
+} // namespace hud
@@ -0,0 +1,41 @@
+#pragma once
+#include "field.hpp"
+#include "hud.hpp"
+#include <cstdint>
+
+// =====================================================
+//  Helpers internos expuestos para medirlos/verificarlos por separado
+//  (bench). No son API estable: pueden cambiar con la implementación.
+// =====================================================
+namespace detail {
+
+// Conversión de color usada por la etapa HSL de NebulaField (field.cpp)
+void rgb_to_hsl(uint8_t R, uint8_t G, uint8_t B, float& h, float& s, float& l);
+void hsl_to_rgb(float h, float s, float l, uint8_t& R, uint8_t& G, uint8_t& B);
+
+// Expande una fila reducida a las columnas de salida [x0,x1) (nearest,
+// sx = min(SW-1, x*s) - sxbase); camino low-res de render_frame (renderer.cpp)
+void upscale_row(uint32_t* dst, const uint32_t* src, int x0, int x1, int sxbase, float s, int SW);
+
+// Copia W x H píxeles a un destino con pitch en bytes (textura SDL);
+// stream = stores non-temporal
+void copy_rows(void* dst, int pitch, const uint32_t* src, int W, int H, bool stream = false);
+
+// Copia n píxeles con stores non-temporal (SSE2) donde dst esté alineado a
+// 16 B; el resto con stores normales. Tras la última fila hace falta
+// stream_fence() antes de que otro hilo lea el destino.
+void stream_row(uint32_t* dst, const uint32_t* src, int n);
+void stream_fence();
+
+} // namespace detail
+
+// Acceso a los kernels privados de NebulaField (friend en field.hpp)
+struct NebulaFieldProbe {
+  static float noise3(const NebulaField& f, float x, float y, float z) { return f.noise3(x, y, z); }
+  static float fbm(const NebulaField& f, float x, float y, float z, int o) { return f.fbm(x, y, z, o); }
+  static float rfbm(const NebulaField& f, float x, float y, float z, int o) { return f.rfbm(x, y, z, o); }
+  static float gnoise3_dx(const NebulaField& f, float x, float y, float z) { return f.gnoise3(x, y, z).dx; }
+  static void color_stage(const NebulaField& f, float shade, float t, uint8_t& r, uint8_t& g, uint8_t& b) {
+    f.color_stage(shade, t, r, g, b);
+  }
+};
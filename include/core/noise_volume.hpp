@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Volumen periódico N^3 (uint16) con los valores del lattice del value noise.
+// Se construye una vez por seed (en paralelo) y, opcionalmente, se persiste en
+// un archivo de cache que se mapea en memoria en los siguientes arranques.
+class NoiseVolume {
+public:
+  // lattice(i,j,k) -> valor en [0,65535] del nodo (i,j,k), con 0 <= i,j,k < size
+  using LatticeFn = std::function<uint16_t(int, int, int)>;
+
+  // size debe ser potencia de 2; cache_dir vacío = sin persistencia
+  NoiseVolume(uint32_t seed, int size, const std::string& cache_dir, const LatticeFn& lattice);
+  ~NoiseVolume();
+  NoiseVolume(const NoiseVolume&) = delete;
+  NoiseVolume& operator=(const NoiseVolume&) = delete;
+
+  int size() const { return n_; }
+  bool from_cache() const { return from_cache_; }
+  double startup_ms() const { return startup_ms_; }
+
+  // Nodo (x,y,z) con wrap periódico
+  uint16_t at(int x, int y, int z) const {
+    return data_[((size_t(z & mask_) * n_) + size_t(y & mask_)) * n_ + size_t(x & mask_)];
+  }
+
+private:
+  int n_ = 0, mask_ = 0;
+  const uint16_t* data_ = nullptr;
+  std::vector<uint16_t> owned_;  // si se construyó en memoria
+  void*  map_ = nullptr;         // si se cargó por mmap
+  size_t map_bytes_ = 0;
+  bool   from_cache_ = false;
+  double startup_ms_ = 0.0;
+
+  bool load_cache(const std::string& path, uint32_t seed);
+  void save_cache(const std::string& path, uint32_t seed) const;
+  void build(const LatticeFn& lattice);
+};
@@ -0,0 +1,24 @@
+#pragma once
+#include <chrono>
+#include <string>
+
+// Limitador de FPS: duerme hasta el próximo deadline (sleep_until) y
+// completa los últimos ~0.3 ms con yield para no perder precisión.
+class FramePacer {
+public:
+  explicit FramePacer(double fps_cap);
+  void wait();                 // no-op si fps_cap <= 0
+  bool enabled() const { return period_.count() > 0; }
+private:
+  using clk = std::chrono::steady_clock;
+  clk::duration period_{0};
+  clk::time_point deadline_ = clk::now();
+};
+
+// Segundos de CPU consumidos por el proceso (todos los hilos)
+double process_cpu_seconds();
+
+// OMP_WAIT_POLICY se lee al cargar el runtime de OpenMP, así que para
+// cambiarlo se re-ejecuta el binario con la variable ya exportada (Linux).
+// policy: "active" | "passive" | "default" (no tocar)
+void apply_omp_wait_policy(const std::string& policy, char** argv);
@@ -0,0 +1,71 @@
+#pragma once
+#include "aligned.hpp"
+#include "app_config.hpp"
+#include "executor.hpp"
+#include "field.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hud { class Overlay; }
+
+// Parámetros de render de un frame (forma del tile, escala, paralelismo).
+// El schedule/chunk de OpenMP es global (omp_set_schedule + schedule(runtime)).
+struct RenderParams {
+  int   tile_w = 32, tile_h = 32;
+  float scale  = 1.0f;     // render_scale (low-res + upscale si < 1)
+  bool  use_omp = false;
+  bool  stream  = false;   // filas terminadas con stores non-temporal
+};
+
+// Deriva los parámetros desde la config: tile_w/tile_h explícitos o,
+// si valen 0, tile cuadrado a partir de omp_chunk (clamp 8..64).
+// --stream auto activa los stores non-temporal si el frame supera la LLC.
+RenderParams render_params_from(const AppConfig& cfg, bool use_omp);
+
+// Tamaño de la cache de último nivel en bytes (16 MB si no se puede leer)
+size_t llc_bytes();
+
+// Contadores de tráfico de escritura de render_frame (bytes acumulados)
+struct RenderStats {
+  std::atomic<uint64_t> bytes_written{0};   // stores normales (pasan por cache)
+  std::atomic<uint64_t> bytes_streamed{0};  // stores non-temporal
+  uint64_t total() const { return bytes_written + bytes_streamed; }
+  void reset() { bytes_written = 0; bytes_streamed = 0; }
+};
+
+// Aplica schedule/chunk (omp_set_schedule) y nº de hilos (0 = no tocar).
+// No-op si no se compiló con OpenMP.
+void apply_omp_runtime(const std::string& schedule, int chunk, int threads);
+
+// Subrectángulo del frame, en píxeles del frame completo (w/h = 0 -> hasta el borde)
+struct FrameRect { int x = 0, y = 0, w = 0, h = 0; };
+
+// Frame a renderizar con render_frame (API embebible, sin SDL)
+struct FrameDesc {
+  const NebulaField* field = nullptr;
+  int width = 0, height = 0;   // tamaño del frame completo
+  FrameRect rect;              // región a escribir (por defecto, todo el frame)
+  RenderParams params;         // tile/escala/stream; use_omp no aplica (lo decide el executor)
+  RenderStats* stats = nullptr; // opcional: suma los bytes escritos en `out`
+  const hud::Overlay* hud = nullptr; // opcional: HUD mezclado en (hud_x, hud_y) del frame
+  int hud_x = 8, hud_y = 8;
+};
+
+// Renderiza desc.rect en `out`: el píxel (rect.x, rect.y) va en out[0] y las
+// filas están separadas `stride` bytes (p.ej. el pitch de una textura).
+// La región se recorta al frame. Un subrectángulo produce exactamente los
+// mismos píxeles que esa zona del frame completo (también con scale < 1),
+// así que un host puede repartir un frame entre sus propios workers.
+// Con params.stream cada fila de tile se arma en un buffer local y se
+// escribe con stores non-temporal (conviene `out` y stride múltiplos de 64 B).
+// Con desc.hud las filas que cruzan el HUD se mezclan en ese buffer antes
+// del store: `out` nunca se lee (sirve una textura bloqueada write-only).
+void render_frame(const FrameDesc& desc, float t, uint32_t* out, size_t stride, Executor& ex);
+void render_frame(const FrameDesc& desc, float t, uint32_t* out, size_t stride); // serial
+
+// Renderiza un frame W x H completo en `pixels` (OpenMP si rp.use_omp)
+void render_field(const NebulaField& field, int W, int H, const RenderParams& rp, float t,
+                  PixelBuffer& pixels, RenderStats* stats = nullptr);
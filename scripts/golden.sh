@@ -0,0 +1,17 @@
+#!/usr/bin/env bash
+# Regresión golden (ver src/bench/golden.hpp)
+#   scripts/golden.sh check                 ctest: imágenes vs tests/golden
+#   scripts/golden.sh record                regraba tests/golden (cambio visual intencional)
+#   scripts/golden.sh perf-record [dir]     referencia local de tiempos (antes de optimizar)
+#   scripts/golden.sh perf-check  [dir] [perf_tol]
+set -euo pipefail
+mode="${1:-check}"; dir="${2:-build/golden-perf}"
+cmake -S . -B build -DCMAKE_BUILD_TYPE=Release >/dev/null
+cmake --build build --config Release --target bench -- -j
+case "$mode" in
+  check)       ctest --test-dir build -R '^golden$' --output-on-failure ;;
+  record)      ./build/bin/bench --golden-record tests/golden && rm -f tests/golden/timings.txt ;;
+  perf-record) ./build/bin/bench --golden-record "$dir" ;;
+  perf-check)  ./build/bin/bench --golden-check "$dir" --tol 2 --perf-tol "${3:-1.25}" ;;
+  *) echo "usage: $0 check|record|perf-record [dir]|perf-check [dir] [perf_tol]" >&2; exit 2 ;;
+esac
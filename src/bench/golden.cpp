@@ -0,0 +1,154 @@
+#include "golden.hpp"
+#include "core/app_config.hpp"
+#include "core/field.hpp"
+#include "core/renderer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+// Un caso de referencia: tamaño, octavas, render_scale, backend y frame
+struct GoldenCase {
+  int W, H, n;
+  float scale;
+  const char* noise;
+  int frame;   // t = frame / 60 (secuencia fija del modo determinista)
+};
+
+// Tamaños chicos: las referencias se versionan en tests/golden (~1.3 MB)
+static std::vector<GoldenCase> golden_cases() {
+  std::vector<GoldenCase> v;
+  for (int n : {1, 6, 12})
+    for (float s : {1.0f, 0.5f}) {
+      for (int f : {0, 90}) v.push_back({160, 120, n, s, "value", f});
+      v.push_back({192, 128, n, s, "value", 90});   // ancho no múltiplo del tile
+    }
+  // Backends alternativos de ruido
+  v.push_back({160, 120, 6, 1.0f, "gradient", 90});
+  v.push_back({160, 120, 6, 1.0f, "volume",   90});
+  return v;
+}
+
+static std::string case_name(const GoldenCase& c) {
+  char b[96];
+  std::snprintf(b, sizeof(b), "w%dx%d_n%d_s%.2f_%s_f%d", c.W, c.H, c.n, c.scale, c.noise, c.frame);
+  return b;
+}
+
+// Renderiza el caso; devuelve ms (mejor de 3) y deja la imagen en `pixels`
+static double render_case(const GoldenCase& c, PixelBuffer& pixels) {
+  AppConfig cfg;
+  cfg.width = c.W; cfg.height = c.H; cfg.n = c.n; cfg.seed = 1234;
+  cfg.render_scale = c.scale; cfg.noise = c.noise; cfg.deterministic = true;
+  cfg.clamp_to_valid_ranges();
+  NebulaField field(cfg);
+  RenderParams rp = render_params_from(cfg, true);
+
+  using clk = std::chrono::steady_clock;
+  double best = 1e30;
+  for (int k = 0; k < 3; ++k) {
+    auto a = clk::now();
+    render_field(field, c.W, c.H, rp, c.frame / 60.f, pixels);
+    best = std::min(best, std::chrono::duration<double, std::milli>(clk::now() - a).count());
+  }
+  return best;
+}
+
+// PPM binario (P6): el canal alpha siempre es 255, no se guarda
+static bool write_ppm(const std::string& path, const PixelBuffer& px, int W, int H) {
+  FILE* f = std::fopen(path.c_str(), "wb");
+  if (!f) return false;
+  std::fprintf(f, "P6\n%d %d\n255\n", W, H);
+  std::vector<uint8_t> row((size_t)W * 3);
+  for (int y = 0; y < H; ++y) {
+    for (int x = 0; x < W; ++x) {
+      uint32_t p = px[(size_t)y * W + x];
+      row[x*3+0] = uint8_t(p >> 16); row[x*3+1] = uint8_t(p >> 8); row[x*3+2] = uint8_t(p);
+    }
+    std::fwrite(row.data(), 1, row.size(), f);
+  }
+  return std::fclose(f) == 0;
+}
+
+static bool read_ppm(const std::string& path, std::vector<uint8_t>& rgb, int& W, int& H) {
+  FILE* f = std::fopen(path.c_str(), "rb");
+  if (!f) return false;
+  int maxv = 0;
+  bool ok = std::fscanf(f, "P6 %d %d %d", &W, &H, &maxv) == 3 && maxv == 255 && std::fgetc(f) != EOF;
+  if (ok) {
+    rgb.resize((size_t)W * H * 3);
+    ok = std::fread(rgb.data(), 1, rgb.size(), f) == rgb.size();
+  }
+  std::fclose(f);
+  return ok;
+}
+
+int golden_record(const std::string& dir) {
+  std::error_code ec;
+  std::filesystem::create_directories(dir, ec);
+  std::ofstream timings(dir + "/timings.txt", std::ios::trunc);
+  PixelBuffer px;
+  int failed = 0;
+  for (const GoldenCase& c : golden_cases()) {
+    double ms = render_case(c, px);
+    std::string name = case_name(c);
+    if (!write_ppm(dir + "/" + name + ".ppm", px, c.W, c.H)) {
+      std::fprintf(stderr, "[GOLDEN] cannot write %s/%s.ppm\n", dir.c_str(), name.c_str());
+      ++failed; continue;
+    }
+    timings << name << ' ' << ms << '\n';
+    std::printf("[GOLDEN] recorded %-36s %8.2f ms\n", name.c_str(), ms);
+  }
+  return failed;
+}
+
+int golden_check(const std::string& dir, int tol, double perf_tol) {
+  std::map<std::string, double> ref_ms;
+  {
+    std::ifstream in(dir + "/timings.txt");
+    std::string name; double ms;
+    while (in >> name >> ms) ref_ms[name] = ms;
+  }
+
+  PixelBuffer px;
+  std::vector<uint8_t> ref;
+  int failed = 0;
+  for (const GoldenCase& c : golden_cases()) {
+    const std::string name = case_name(c);
+    int RW = 0, RH = 0;
+    if (!read_ppm(dir + "/" + name + ".ppm", ref, RW, RH) || RW != c.W || RH != c.H) {
+      std::printf("[GOLDEN] FAIL %-36s missing/invalid reference\n", name.c_str());
+      ++failed; continue;
+    }
+    double ms = render_case(c, px);
+
+    // Diferencia máxima por canal y nº de píxeles fuera de tolerancia
+    int maxd = 0; long bad = 0;
+    for (size_t i = 0; i < px.size(); ++i) {
+      uint32_t p = px[i];
+      int d = std::max({std::abs(int((p >> 16) & 0xFF) - ref[i*3+0]),
+                        std::abs(int((p >>  8) & 0xFF) - ref[i*3+1]),
+                        std::abs(int( p        & 0xFF) - ref[i*3+2])});
+      maxd = std::max(maxd, d);
+      if (d > tol) ++bad;
+    }
+
+    auto it = ref_ms.find(name);
+    double ratio = (it != ref_ms.end() && it->second > 0) ? ms / it->second : 0.0;
+    bool visual_ok = (bad == 0);
+    bool perf_ok = perf_tol <= 0.0 || ratio == 0.0 || ratio <= perf_tol;
+    std::printf("[GOLDEN] %s %-36s maxdiff=%3d bad_px=%-6ld %8.2f ms (x%.2f)\n",
+                (visual_ok && perf_ok) ? "ok  " : "FAIL", name.c_str(), maxd, bad, ms, ratio);
+    if (!visual_ok || !perf_ok) ++failed;
+  }
+  if (perf_tol > 0.0)
+    std::printf("[GOLDEN] %d case(s) failed (tol=%d, perf_tol=%.2f)\n", failed, tol, perf_tol);
+  else
+    std::printf("[GOLDEN] %d case(s) failed (tol=%d, perf not checked)\n", failed, tol);
+  return failed;
+}
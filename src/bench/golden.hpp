@@ -0,0 +1,15 @@
+#pragma once
+#include <string>
+
+// =====================================================
+//  Regresión con imágenes golden (modo --deterministic)
+//  - record: renderiza los casos de referencia y guarda <dir>/<caso>.ppm
+//    + <dir>/timings.txt (ms por caso, mejor de 3)
+//  - check: vuelve a renderizar y compara por canal (<= tol) y tiempo
+//    (<= perf_tol x referencia; perf_tol <= 0 no mira tiempos).
+//    Devuelve el nº de casos que fallan.
+//  Las imágenes de referencia viven en tests/golden (test CTest `golden`);
+//  los tiempos dependen de la máquina y no se versionan (`golden_perf`).
+// =====================================================
+int golden_record(const std::string& dir);
+int golden_check(const std::string& dir, int tol, double perf_tol);
@@ -0,0 +1,224 @@
+#include "core/aligned.hpp"
+#include "core/app_config.hpp"
+#include "core/field.hpp"
+#include "core/hud.hpp"
+#include "core/internal.hpp"
+#include "golden.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <unistd.h>
+#endif
+
+// =====================================================
+//  bench: microbenchmarks de los kernels (sin SDL)
+//  Uso: bench [--min-ms <int>] [--filter <substr>] [--json <path|->]
+//         bench --golden-record <dir> | --golden-check <dir> [--tol <int>] [--perf-tol <f>]
+//  Imprime ns/op y Mpixel/s; --json vuelca lo mismo para comparar commits
+//  (con --json - el texto legible, incluidos los logs del core, va a stderr).
+//  Los modos golden (ver golden.hpp) salen con código != 0 si algo falla.
+// =====================================================
+
+struct Result {
+  std::string name, param;
+  double ns_op = 0.0, mpix_s = 0.0;
+};
+
+static volatile uint32_t g_sink; // evita que el compilador elimine el trabajo
+
+static int         g_min_ms = 200;
+static std::string g_filter;
+static std::vector<Result> g_results;
+static FILE*       g_json_out = nullptr;  // destino de --json - (stdout original)
+
+static bool wanted(const std::string& name, const std::string& param) {
+  return g_filter.empty() || (name + " " + param).find(g_filter) != std::string::npos;
+}
+
+// Ejecuta fn(i) en lotes hasta acumular al menos g_min_ms.
+// pix_per_op: píxeles producidos por llamada (0 = no aplica).
+template <class Fn>
+static void run(const std::string& name, const std::string& param, double pix_per_op, Fn fn) {
+  if (!wanted(name, param)) return;
+  using clk = std::chrono::steady_clock;
+  fn(0); // warmup
+  long iters = 0, batch = 1;
+  double elapsed = 0.0;
+  auto t0 = clk::now();
+  while (elapsed < g_min_ms * 1e6) {
+    for (long i = 0; i < batch; ++i) fn(iters + i);
+    iters += batch;
+    elapsed = std::chrono::duration<double, std::nano>(clk::now() - t0).count();
+    if (batch < (1L << 20)) batch *= 2;
+  }
+  Result r{name, param, elapsed / iters, 0.0};
+  if (pix_per_op > 0) r.mpix_s = pix_per_op * iters / (elapsed * 1e-3);
+  g_results.push_back(r);
+  std::printf("[BENCH] %-14s %-12s %12.2f ns/op", name.c_str(), param.c_str(), r.ns_op);
+  if (pix_per_op > 0) std::printf("  %9.2f Mpix/s", r.mpix_s);
+  std::printf("\n");
+  std::fflush(stdout);
+}
+
+static void write_json(const std::string& path) {
+  FILE* f = (path == "-") ? g_json_out : std::fopen(path.c_str(), "w");
+  if (!f) { std::fprintf(stderr, "[warn] cannot write '%s'\n", path.c_str()); return; }
+  std::fprintf(f, "{\"results\":[\n");
+  for (size_t i = 0; i < g_results.size(); ++i) {
+    const Result& r = g_results[i];
+    std::fprintf(f, "  {\"name\":\"%s\",\"param\":\"%s\",\"ns_per_op\":%.3f,\"mpix_per_s\":%.3f}%s\n",
+                 r.name.c_str(), r.param.c_str(), r.ns_op, r.mpix_s,
+                 i + 1 < g_results.size() ? "," : "");
+  }
+  std::fprintf(f, "]}\n");
+  if (path != "-") std::fclose(f);
+  else std::fflush(f);
+}
+
+// Coordenadas pseudoaleatorias baratas para los taps de ruido
+static inline float coord(long i, float k) { return float((i * 2654435761u) & 0xFFFF) * k; }
+
+int main(int argc, char** argv) {
+  std::string json, golden_rec, golden_chk;
+  int tol = 2; double perf_tol = 1.25;
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "--min-ms") && i + 1 < argc) g_min_ms = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--golden-record") && i + 1 < argc) golden_rec = argv[++i];
+    else if (!std::strcmp(argv[i], "--golden-check") && i + 1 < argc) golden_chk = argv[++i];
+    else if (!std::strcmp(argv[i], "--tol") && i + 1 < argc) tol = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--perf-tol") && i + 1 < argc) perf_tol = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--filter") && i + 1 < argc) g_filter = argv[++i];
+    else if (!std::strcmp(argv[i], "--json") && i + 1 < argc) json = argv[++i];
+    else if (!std::strcmp(argv[i], "--help")) {
+      std::printf("Usage: %s [--min-ms <int>] [--filter <substr>] [--json <path|->]\n"
+                  "       %s --golden-record <dir> | --golden-check <dir> [--tol <int>] [--perf-tol <f>]\n",
+                  argv[0], argv[0]);
+      return 0;
+    }
+  }
+
+  // Regresión golden (imagen + tiempo) en lugar de microbenchmarks
+  if (!golden_rec.empty()) return golden_record(golden_rec) ? 1 : 0;
+  if (!golden_chk.empty()) return golden_check(golden_chk, tol, perf_tol) ? 1 : 0;
+
+  // --json -: stdout queda sólo para el JSON; todo lo demás (los [BENCH]
+  // de aquí y los logs del core, p.ej. [NOISE]) se redirige a stderr
+  g_json_out = stdout;
+  if (json == "-") {
+#if defined(__unix__) || defined(__APPLE__)
+    std::fflush(stdout);
+    int fd = dup(STDOUT_FILENO);
+    FILE* f = fd >= 0 ? fdopen(fd, "w") : nullptr;
+    if (f) { g_json_out = f; dup2(STDERR_FILENO, STDOUT_FILENO); }
+#endif
+  }
+
+  AppConfig cfg;
+  cfg.width = 1280; cfg.height = 720; cfg.seed = 1;
+  cfg.clamp_to_valid_ranges();
+  NebulaField field(cfg);
+
+  // ---- ruido ----
+  run("noise3", "value", 0, [&](long i) {
+    g_sink += uint32_t(NebulaFieldProbe::noise3(field, coord(i, 1e-3f), coord(i + 7, 1e-3f), 0.3f) * 255.f);
+  });
+  if (wanted("noise3", "volume64")) {
+    AppConfig c = cfg; c.noise = "volume";
+    NebulaField fv(c);
+    run("noise3", "volume64", 0, [&](long i) {
+      g_sink += uint32_t(NebulaFieldProbe::noise3(fv, coord(i, 1e-3f), coord(i + 7, 1e-3f), 0.3f) * 255.f);
+    });
+  }
+  run("gnoise3", "gradient", 0, [&](long i) {
+    g_sink += uint32_t(NebulaFieldProbe::gnoise3_dx(field, coord(i, 1e-3f), coord(i + 7, 1e-3f), 0.3f) * 255.f);
+  });
+
+  // ---- fBm / ridged / pixel completo por nº de octavas ----
+  for (int oct : {1, 4, 8, 12}) {
+    std::string p = "n=" + std::to_string(oct);
+    run("fbm", p, 0, [&](long i) {
+      g_sink += uint32_t(NebulaFieldProbe::fbm(field, coord(i, 1e-4f), coord(i + 7, 1e-4f), 0.3f, oct) * 255.f);
+    });
+    run("rfbm", p, 0, [&](long i) {
+      g_sink += uint32_t(NebulaFieldProbe::rfbm(field, coord(i, 1e-4f), coord(i + 7, 1e-4f), 0.3f, oct) * 255.f);
+    });
+    AppConfig c = cfg; c.n = oct;
+    NebulaField fo(c);
+    run("sample_pixel", p, 1, [&](long i) {
+      g_sink += fo.sample_pixel(int(i % c.width), int((i / c.width) % c.height), 1.0f);
+    });
+  }
+
+  // ---- etapa de color HSL ----
+  run("color_stage", "", 1, [&](long i) {
+    uint8_t r, g, b;
+    NebulaFieldProbe::color_stage(field, float(i & 1023) / 1023.f, 1.0f, r, g, b);
+    g_sink += r + g + b;
+  });
+
+  // ---- kernels de memoria por resolución ----
+  const int res[][2] = {{640, 360}, {1280, 720}, {1920, 1080}, {3840, 2160}};
+  for (auto& wh : res) {
+    const int W = wh[0], H = wh[1];
+    const std::string p = std::to_string(W) + "x" + std::to_string(H);
+    PixelBuffer frame((size_t)W * H, 0xFF204060u);
+
+    // upscale desde render_scale 0.5, como el camino low-res de render_frame:
+    // cada fila reducida se expande una vez (upscale_row) y se copia a las
+    // filas de salida que la usan
+    const float s = 0.5f;
+    const int SW = int(W * s), SH = int(H * s);
+    PixelBuffer low((size_t)SW * SH, 0xFF102030u), wide(W);
+    run("upscale", p, double(W) * H, [&](long) {
+      int last = -1;
+      for (int y = 0; y < H; ++y) {
+        const int sy = std::min(SH - 1, int(y * s));
+        if (sy != last) { detail::upscale_row(wide.data(), low.data() + (size_t)sy * SW, 0, W, 0, s, SW); last = sy; }
+        std::memcpy(frame.data() + (size_t)y * W, wide.data(), (size_t)W * sizeof(uint32_t));
+      }
+      g_sink += frame[(size_t)W * H / 2];
+    });
+
+    // copia fila a fila a un destino con pitch (como la textura SDL)
+    const int pitch = W * 4 + 64;
+    std::vector<uint8_t, AlignedAllocator<uint8_t, 64>> tex((size_t)pitch * H);
+    run("copy_rows", p, double(W) * H, [&](long) {
+      detail::copy_rows(tex.data(), pitch, frame.data(), W, H);
+      g_sink += tex[(size_t)pitch * (H / 2)];
+    });
+    // idem con stores non-temporal (--stream)
+    run("copy_rows_nt", p, double(W) * H, [&](long) {
+      detail::copy_rows(tex.data(), pitch, frame.data(), W, H, true);
+      g_sink += tex[(size_t)pitch * (H / 2)];
+    });
+
+    // HUD: composición de la capa cacheada (bbox fija) sobre el frame
+    hud::Overlay ov;
+    const int sc = (W >= 1600 ? 4 : 3);
+    ov.update("FPS 59.9  x8  n=8  s=1.00\nR 12.3  H 0.02  U 1.4 MS", sc);
+    run("hud_composite", p, double(ov.width()) * ov.height(), [&](long) {
+      ov.composite(frame.data(), (size_t)W * 4, W, H, 8, 8);
+      g_sink += frame[(size_t)W * 10 + 10];
+    });
+  }
+
+  // HUD: reconstrucción de la capa (sólo cuando cambia el texto)
+  {
+    hud::Overlay ov;
+    run("hud_rebuild", "scale=4", 0, [&](long i) {
+      char txt[64];
+      std::snprintf(txt, sizeof(txt), "FPS %ld.0  x8  n=8  s=1.00", i % 1000);
+      ov.update(txt, 4);
+      g_sink += uint32_t(ov.width());
+    });
+  }
+
+  if (!json.empty()) write_json(json);
+  return 0;
+}
@@ -13,9 +13,16 @@ static inline float clampf(float v, float lo, float hi){ return std::max(lo, std
  * - Clamps window dimensions (`width`, `height`) to minimum values.
  * - Clamps noise parameters (`n`, `lacunarity`, `persistence`, `zspeed`) to valid ranges.
  * - Clamps rendering scale (`render_scale`) to supported range.
+ * - Normalizes and validates framebuffer streaming mode (`stream`), falling back to "auto".
+ * - Clamps animation drift (`drift`) and frame-rate cap (`fps_cap`).
+ * - Normalizes and validates OpenMP wait policy (`wait_policy`), falling back to "default".
  * - Normalizes and validates OpenMP schedule (`omp_schedule`), falling back to "static" if invalid.
  * - Clamps OpenMP chunk size (`omp_chunk`) to a reasonable range.
+ * - Clamps explicit tile shape (`tile_w`, `tile_h`) and thread count (`threads`).
+ * - Clamps the autotune quality floor (`autotune_quality`) to the render_scale range.
  * - Normalizes and validates color palette (`palette`), falling back to "nebula" if invalid.
+ * - Normalizes and validates noise backend (`noise`), falling back to "value" if invalid.
+ * - Validates the noise volume size (`noise_vol`), falling back to 64 if not 32/64/128.
  *
  * Emits warnings to stderr if invalid values are detected and corrected.
  */
@@ -29,10 +36,23 @@ void AppConfig::clamp_to_valid_ranges() {
   lacunarity  = clampf(lacunarity, 1.5f, 3.0f);
   persistence = clampf(persistence, 0.05f, 0.95f);
   zspeed      = clampf(zspeed, 0.0f, 5.0f);
+  drift       = clampf(drift, 0.0f, 3.0f);
+
+  // pacing (0 = sin límite)
+  fps_cap = clampf(fps_cap, 0.0f, 240.0f);
 
   // render low-res
   render_scale = clampf(render_scale, 0.3f, 1.0f);
 
+  // stores non-temporal del framebuffer
+  for (char &ch : stream)
+    ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+  if (stream!="on" && stream!="off" && stream!="auto") {
+    std::fprintf(stderr, "[warn] invalid --stream '%s' -> using 'auto'\n",
+                 stream.c_str());
+    stream = "auto";
+  }
+
   // normaliza schedule a minúsculas y valida
   for (char &ch : omp_schedule)
     ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
@@ -43,9 +63,24 @@ void AppConfig::clamp_to_valid_ranges() {
     omp_schedule = "static";
   }
 
+  // política de espera del equipo OpenMP
+  for (char &ch : wait_policy)
+    ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+  if (wait_policy!="active" && wait_policy!="passive" && wait_policy!="default") {
+    std::fprintf(stderr, "[warn] invalid --wait-policy '%s' -> using 'default'\n",
+                 wait_policy.c_str());
+    wait_policy = "default";
+  }
+
   // chunk razonable
   omp_chunk = clampi(omp_chunk, 1, 512);
 
+  // tile explícito (0 = derivado de chunk); filas completas permitidas
+  tile_w  = tile_w > 0 ? std::min(tile_w, width)  : 0;
+  tile_h  = tile_h > 0 ? std::min(tile_h, height) : 0;
+  threads = clampi(threads, 0, 256);
+  autotune_quality = clampf(autotune_quality, 0.3f, 1.0f);
+
   // paletas permitidas
   for (char &ch : palette)
     ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
@@ -54,4 +89,19 @@ void AppConfig::clamp_to_valid_ranges() {
                  palette.c_str());
     palette = "nebula";
   }
+
+  // backends de ruido permitidos
+  for (char &ch : noise)
+    ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+  if (noise!="value" && noise!="gradient" && noise!="volume") {
+    std::fprintf(stderr, "[warn] Invalid --noise '%s' -> using 'value'\n",
+                 noise.c_str());
+    noise = "value";
+  }
+
+  // volumen periódico: potencia de 2 (wrap con máscara)
+  if (noise_vol!=32 && noise_vol!=64 && noise_vol!=128) {
+    std::fprintf(stderr, "[warn] Invalid --noise-vol %d -> using 64\n", noise_vol);
+    noise_vol = 64;
+  }
 }
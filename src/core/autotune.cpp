@@ -0,0 +1,205 @@
+#include "core/autotune.hpp"
+#include "core/field.hpp"
+#include "core/renderer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#if defined(_OPENMP)
+  #include <omp.h>
+#endif
+
+// Modelo de CPU (Linux: /proc/cpuinfo); "unknown-cpu" si no se puede leer
+static std::string cpu_model() {
+  std::ifstream in("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.rfind("model name", 0) == 0 || line.rfind("Hardware", 0) == 0) {
+      auto p = line.find(':');
+      if (p == std::string::npos) continue;
+      std::string m = line.substr(p + 1);
+      m.erase(0, m.find_first_not_of(" \t"));
+      for (char& c : m) if (c == '|' || c == '\t') c = ' ';
+      if (!m.empty()) return m;
+    }
+  }
+  return "unknown-cpu";
+}
+
+static std::string cache_path(const AppConfig& cfg) {
+  if (!cfg.autotune_cache.empty()) return cfg.autotune_cache;
+  if (const char* x = std::getenv("XDG_CACHE_HOME")) return std::string(x) + "/nebula-autotune.txt";
+  if (const char* h = std::getenv("HOME")) return std::string(h) + "/.cache/nebula-autotune.txt";
+  return "nebula-autotune.txt";
+}
+
+std::string autotune_key(const AppConfig& cfg) {
+  std::ostringstream k;
+  k << cpu_model() << '|' << std::thread::hardware_concurrency() << '|'
+    << cfg.width << 'x' << cfg.height;
+  return k.str();
+}
+
+// Tiempo (ms) por frame de la banda W x BH: 1 warmup + mejor de 2
+static double time_frames(const NebulaField& field, int W, int BH, const RenderParams& rp,
+                          PixelBuffer& pixels) {
+  using clk = std::chrono::steady_clock;
+  render_field(field, W, BH, rp, 0.f, pixels);
+  double best = 1e30;
+  for (int k = 1; k <= 2; ++k) {
+    auto a = clk::now();
+    render_field(field, W, BH, rp, 0.05f * k, pixels);
+    best = std::min(best, std::chrono::duration<double, std::milli>(clk::now() - a).count());
+  }
+  return best;
+}
+
+// -----------------------------------------------------
+// autotune_run
+// Descripción:
+//   - Mide sobre una banda superior de ~256K píxeles (ancho completo) para
+//     que el barrido dure segundos incluso a 4K.
+//   - Descenso de coordenadas: cada etapa fija el mejor valor de su eje.
+//   - La escala sólo baja hasta autotune_quality (piso de calidad).
+// -----------------------------------------------------
+TuneResult autotune_run(const AppConfig& cfg) {
+  const int W = cfg.width, H = cfg.height;
+  const int BH = std::clamp(262144 / std::max(1, W), std::min(64, H), H);
+  NebulaField field(cfg);
+  PixelBuffer pixels;
+
+#if defined(_OPENMP)
+  const bool use_omp = true;
+  const int hw = omp_get_num_procs();
+#else
+  const bool use_omp = false;
+  const int hw = 1;
+#endif
+
+  TuneResult best;
+  best.schedule = cfg.omp_schedule;
+  best.chunk    = cfg.omp_chunk;
+  best.threads  = cfg.threads > 0 ? cfg.threads : hw;
+  RenderParams rp0 = render_params_from(cfg, use_omp);
+  best.tile_w = rp0.tile_w; best.tile_h = rp0.tile_h;
+  best.scale  = 1.0f;
+
+  std::printf("[TUNE] key='%s' band=%dx%d\n", autotune_key(cfg).c_str(), W, BH);
+
+  auto measure = [&](const TuneResult& c) {
+    apply_omp_runtime(c.schedule, c.chunk, c.threads);
+    RenderParams rp; rp.tile_w = c.tile_w; rp.tile_h = c.tile_h;
+    rp.scale = c.scale; rp.use_omp = use_omp;
+    double ms = time_frames(field, W, BH, rp, pixels);
+    std::printf("[TUNE] tile=%dx%d sched=%s chunk=%d th=%d s=%.2f -> %.2f ms\n",
+                c.tile_w, c.tile_h, c.schedule.c_str(), c.chunk, c.threads, c.scale, ms);
+    std::fflush(stdout);
+    return ms;
+  };
+  auto try_cand = [&](TuneResult c) {
+    c.ms = measure(c);
+    if (c.ms < best.ms) best = c;
+  };
+  best.ms = measure(best);
+
+  // 1) Forma del tile (incluye franjas de filas completas)
+  const int tiles[][2] = {{16,16},{32,32},{64,64},{64,16},{128,8},{W,8},{W,2}};
+  for (auto& t : tiles) {
+    TuneResult c = best; c.tile_w = std::min(t[0], W); c.tile_h = std::min(t[1], BH);
+    if (c.tile_w == best.tile_w && c.tile_h == best.tile_h) continue;
+    try_cand(c);
+  }
+
+  if (use_omp) {
+    // 2) Schedule x chunk (chunk en unidades de tile del collapse(2))
+    for (const char* sc : {"static", "dynamic", "guided"})
+      for (int ch : {1, 2, 8, 32}) {
+        TuneResult c = best; c.schedule = sc; c.chunk = ch;
+        if (c.schedule == best.schedule && c.chunk == best.chunk) continue;
+        try_cand(c);
+      }
+
+    // 3) Hilos: hw, hw/2, hw/4, ... 1
+    for (int th = hw; th >= 1; th /= 2) {
+      if (th == best.threads) continue;
+      TuneResult c = best; c.threads = th;
+      try_cand(c);
+    }
+  }
+
+  // 4) render_scale respetando el piso de calidad
+  for (float sc : {0.85f, 0.75f, 0.6f, 0.5f, 0.4f, 0.3f}) {
+    if (sc < cfg.autotune_quality - 1e-4f) break;
+    TuneResult c = best; c.scale = sc;
+    try_cand(c);
+  }
+
+  std::printf("[TUNE] best tile=%dx%d sched=%s chunk=%d th=%d s=%.2f (%.2f ms/band)\n",
+              best.tile_w, best.tile_h, best.schedule.c_str(), best.chunk,
+              best.threads, best.scale, best.ms);
+  std::fflush(stdout);
+  return best;
+}
+
+// Formato: una línea por clave -> "<clave>\t<tw> <th> <sched> <chunk> <threads> <scale> <ms>"
+bool autotune_load(const AppConfig& cfg, TuneResult& out) {
+  std::ifstream in(cache_path(cfg));
+  if (!in) return false;
+  const std::string key = autotune_key(cfg);
+  std::string line;
+  while (std::getline(in, line)) {
+    auto tab = line.find('\t');
+    if (tab == std::string::npos || line.compare(0, tab, key) != 0 || tab != key.size()) continue;
+    std::istringstream ss(line.substr(tab + 1));
+    TuneResult r;
+    if (ss >> r.tile_w >> r.tile_h >> r.schedule >> r.chunk >> r.threads >> r.scale >> r.ms) {
+      out = r;
+      return true;
+    }
+  }
+  return false;
+}
+
+void autotune_save(const AppConfig& cfg, const TuneResult& r) {
+  const std::string path = cache_path(cfg);
+  const std::string key = autotune_key(cfg);
+
+  // Conserva las demás claves y reemplaza la nuestra
+  std::vector<std::string> lines;
+  {
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line))
+      if (line.compare(0, key.size() + 1, key + '\t') != 0) lines.push_back(line);
+  }
+  std::ostringstream mine;
+  mine << key << '\t' << r.tile_w << ' ' << r.tile_h << ' ' << r.schedule << ' '
+       << r.chunk << ' ' << r.threads << ' ' << r.scale << ' ' << r.ms;
+  lines.push_back(mine.str());
+
+  std::error_code ec;
+  auto dir = std::filesystem::path(path).parent_path();
+  if (!dir.empty()) std::filesystem::create_directories(dir, ec);
+  std::ofstream out(path, std::ios::trunc);
+  for (auto& l : lines) out << l << '\n';
+  if (!out) {
+    std::fprintf(stderr, "[warn] cannot write autotune cache '%s'\n", path.c_str());
+    return;
+  }
+  std::printf("[TUNE] saved to %s\n", path.c_str());
+}
+
+void autotune_apply(AppConfig& cfg, const TuneResult& r) {
+  cfg.tile_w = r.tile_w;
+  cfg.tile_h = r.tile_h;
+  cfg.omp_schedule = r.schedule;
+  cfg.omp_chunk = r.chunk;
+  cfg.threads = r.threads;
+  cfg.render_scale = r.scale;
+}
@@ -30,14 +30,32 @@ static void print_help(const char* exe) {
     "  -h <int>              height (>=120)\n"
     "  -n <int>              octaves (1..12)\n"
     "  --seed <u32>\n"
+    "  --deterministic       paleta sólo por seed y t = frame/60 (reproducible)\n"
     "  --lacunarity <f>      1.5..3.0\n"
     "  --persistence <f>     0.05..0.95\n"
     "  --zspeed <f>          0..5\n"
     "  --palette <name>      nebula|inferno|ice|bw\n"
+    "  --noise <name>        value|gradient|volume\n"
+    "                        (gradient: warp con derivadas analíticas;\n"
+    "                         volume: volumen periódico precalculado)\n"
+    "  --noise-vol <int>     32|64|128 (lado del volumen)\n"
+    "  --noise-cache <dir>   cache mmap del volumen (por seed y tamaño)\n"
     "  --vsync <0|1>\n"
+    "  --stars <0|1>         estrellas con parpadeo\n"
+    "  --drift <f>           0..3 giro/tono animado (0 + zspeed 0 + stars 0 = escena fija)\n"
+    "  --fps-cap <f>         0..240 límite de FPS (0 = sin límite)\n"
+    "  --wait-policy <active|passive|default>  espera del equipo OpenMP entre frames\n"
     "  --render-scale <f>    0.3..1.0 (low-res render + upscale)\n"
+    "  --progressive <0|1>   primeros frames a 1/8, 1/4, 1/2 de escala (arranque rápido)\n"
+    "  --stream <on|off|auto> stores non-temporal directo a la textura\n"
+    "                        (auto: sólo si el frame no cabe en la LLC)\n"
     "  --schedule <static|dynamic|guided|auto>\n"
     "  --chunk <int>         (1..512)\n"
+    "  --tile <W>x<H>        tile explícito (p.ej. 32x32, 1280x4 = franjas)\n"
+    "  --threads <int>       hilos OpenMP (0 = default)\n"
+    "  --autotune            barrido headless; guarda el mejor en cache\n"
+    "  --autotune-quality <f> render_scale mínimo aceptable (0.3..1.0)\n"
+    "  --autotune-cache <path> archivo de cache (clave: CPU, núcleos, resolución)\n"
     "  --title-fps <0|1>     (alias de show_fps)\n",
     exe);
 }
@@ -54,7 +72,13 @@ static void print_help(const char* exe) {
 //   - Permite ejecutar `--help` para mostrar ayuda y salir.
 // -----------------------------------------------------
 AppConfig parse_cli(int argc, char** argv) {
-  AppConfig cfg;
+  return parse_cli(argc, argv, AppConfig{});
+}
+
+// Igual que parse_cli, pero partiendo de `defaults` (p.ej. valores del
+// autotuner): las opciones explícitas en argv siguen teniendo prioridad.
+AppConfig parse_cli(int argc, char** argv, const AppConfig& defaults) {
+  AppConfig cfg = defaults;
 
   // Si el usuario pide ayuda (--help), mostrar y salir
   for (int i = 1; i < argc; ++i) {
@@ -75,6 +99,8 @@ AppConfig parse_cli(int argc, char** argv) {
   // Opciones adicionales
   v = get_opt(argv, argv+argc, std::string("--seed"));
   if (v) cfg.seed = static_cast<unsigned int>(std::strtoul(v, nullptr, 10));
+  if (std::find(argv, argv+argc, std::string("--deterministic")) != argv+argc)
+    cfg.deterministic = true;
   v = get_opt(argv, argv+argc, std::string("--lacunarity"));
   if (v) cfg.lacunarity = std::atof(v);
   v = get_opt(argv, argv+argc, std::string("--persistence"));
@@ -83,16 +109,49 @@ AppConfig parse_cli(int argc, char** argv) {
   if (v) cfg.zspeed = std::atof(v);
   v = get_opt(argv, argv+argc, std::string("--palette"));
   if (v) cfg.palette = v;
+  v = get_opt(argv, argv+argc, std::string("--noise"));
+  if (v) cfg.noise = v;
+  v = get_opt(argv, argv+argc, std::string("--noise-vol"));
+  if (v) cfg.noise_vol = std::atoi(v);
+  v = get_opt(argv, argv+argc, std::string("--noise-cache"));
+  if (v) cfg.noise_cache = v;
   v = get_opt(argv, argv+argc, std::string("--vsync"));
   if (v) cfg.vsync = (std::string(v)=="1"||std::string(v)=="true"||std::string(v)=="on");
+  v = get_opt(argv, argv+argc, std::string("--stars"));
+  if (v) cfg.stars = (std::string(v)=="1"||std::string(v)=="true"||std::string(v)=="on");
+  v = get_opt(argv, argv+argc, std::string("--drift"));
+  if (v) cfg.drift = std::atof(v);
+
+  // Energía: pacing + política de espera OpenMP
+  v = get_opt(argv, argv+argc, std::string("--fps-cap"));
+  if (v) cfg.fps_cap = std::atof(v);
+  v = get_opt(argv, argv+argc, std::string("--wait-policy"));
+  if (v) cfg.wait_policy = v;
 
   // Extras: renderizado en baja resolución + opciones OpenMP
   v = get_opt(argv, argv+argc, std::string("--render-scale"));
   if (v) cfg.render_scale = std::atof(v);
+  v = get_opt(argv, argv+argc, std::string("--progressive"));
+  if (v) cfg.progressive = (std::string(v)=="1"||std::string(v)=="true"||std::string(v)=="on");
+  v = get_opt(argv, argv+argc, std::string("--stream"));
+  if (v) cfg.stream = v;
   v = get_opt(argv, argv+argc, std::string("--schedule"));
   if (v) cfg.omp_schedule = v;
   v = get_opt(argv, argv+argc, std::string("--chunk"));
   if (v) cfg.omp_chunk = std::atoi(v);
+  v = get_opt(argv, argv+argc, std::string("--tile"));
+  if (v) std::sscanf(v, "%dx%d", &cfg.tile_w, &cfg.tile_h);
+  v = get_opt(argv, argv+argc, std::string("--threads"));
+  if (v) cfg.threads = std::atoi(v);
+
+  // Autotuner
+  if (std::find(argv, argv+argc, std::string("--autotune")) != argv+argc)
+    cfg.autotune = true;
+  v = get_opt(argv, argv+argc, std::string("--autotune-quality"));
+  if (v) cfg.autotune_quality = std::atof(v);
+  v = get_opt(argv, argv+argc, std::string("--autotune-cache"));
+  if (v) cfg.autotune_cache = v;
+
   v = get_opt(argv, argv+argc, std::string("--title-fps"));
   if (v) cfg.show_fps = (std::string(v)=="1"||std::string(v)=="true"||std::string(v)=="on");
 
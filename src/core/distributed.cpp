@@ -0,0 +1,210 @@
+#include "core/distributed.hpp"
+#include "core/aligned.hpp"
+#include "core/field.hpp"
+#include "core/renderer.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <poll.h>
+  #include <sys/socket.h>
+  #include <sys/wait.h>
+  #include <unistd.h>
+  #define NEBULA_DIST 1
+  #if !defined(MSG_NOSIGNAL)
+    #define MSG_NOSIGNAL 0   // macOS: SO_NOSIGPIPE en cada socket (dist_render)
+  #endif
+#endif
+
+#if defined(NEBULA_DIST)
+
+// Cabecera de Job (coord -> worker) y de Rows (worker -> coord)
+struct JobMsg { int32_t frame, y0, y1; };
+
+// send con MSG_NOSIGNAL: si el otro extremo murió da EPIPE en vez de
+// SIGPIPE, sin tocar la disposición de señales del proceso host
+static bool write_all(int fd, const void* p, size_t n) {
+  const char* c = static_cast<const char*>(p);
+  while (n) {
+    ssize_t k = ::send(fd, c, n, MSG_NOSIGNAL);
+    if (k < 0) { if (errno == EINTR) continue; return false; }
+    c += k; n -= size_t(k);
+  }
+  return true;
+}
+
+static bool read_all(int fd, void* p, size_t n) {
+  char* c = static_cast<char*>(p);
+  while (n) {
+    ssize_t k = ::read(fd, c, n);
+    if (k < 0) { if (errno == EINTR) continue; return false; }
+    if (k == 0) return false;   // el otro extremo cerró
+    c += k; n -= size_t(k);
+  }
+  return true;
+}
+
+// -----------------------------------------------------
+// worker_main
+// Descripción:
+//   - Construye su propio NebulaField y renderiza en serie (un proceso =
+//     un núcleo; no se usa OpenMP después del fork).
+//   - Cada Job es un subrectángulo de ancho completo: render_frame da los
+//     mismos píxeles que el frame entero, también con render_scale < 1.
+// -----------------------------------------------------
+[[noreturn]] static void worker_main(int fd, const AppConfig& cfg, const DistOptions& opt) {
+  // Logs del worker a stderr: el coordinador puede usar stdout para los frames
+  ::dup2(STDERR_FILENO, STDOUT_FILENO);
+  NebulaField field(cfg);
+  FrameDesc d;
+  d.field = &field; d.width = cfg.width; d.height = cfg.height;
+  d.params = render_params_from(cfg, false);
+  d.params.stream = false;   // las filas se leen enseguida para enviarlas
+  PixelBuffer rows;
+  JobMsg j;
+  while (read_all(fd, &j, sizeof(j)) && j.frame >= 0) {
+    d.rect = {0, j.y0, cfg.width, j.y1 - j.y0};
+    rows.resize((size_t)cfg.width * (j.y1 - j.y0));
+    render_frame(d, j.frame / opt.fps, rows.data(), (size_t)cfg.width * sizeof(uint32_t));
+    if (!write_all(fd, &j, sizeof(j)) ||
+        !write_all(fd, rows.data(), rows.size() * sizeof(uint32_t))) break;
+  }
+  ::close(fd);
+  _exit(0);
+}
+
+// -----------------------------------------------------
+// dist_render (coordinador)
+// Descripción:
+//   - Lanza los workers y reparte trabajos en orden (frame, banda), hasta
+//     `depth` pendientes por worker para que nunca esperen un Job.
+//   - Sólo se abren frames nuevos si hay lugar en el reorder buffer
+//     (max_buffered; 0 = lo justo para mantener ocupados a los workers).
+//   - Las filas recibidas se copian en el slot de su frame; cuando el
+//     frame `emit` está completo se entrega al sink y el buffer se recicla.
+// -----------------------------------------------------
+DistResult dist_render(const AppConfig& cfg_in, const DistOptions& opt, const FrameSink& sink) {
+  using clk = std::chrono::steady_clock;
+  DistResult res;
+  AppConfig cfg = cfg_in;
+  cfg.deterministic = true;   // misma paleta en todos los procesos
+
+  const int W = cfg.width, H = cfg.height;
+  const int nw = std::max(1, opt.workers);
+  const int depth = std::max(1, opt.depth);
+  const int band = opt.bands ? std::clamp(opt.band_rows, 1, H) : H;
+  const int nbands = (H + band - 1) / band;
+  const int maxbuf = opt.max_buffered > 0 ? opt.max_buffered
+                                          : (nw * depth + nbands - 1) / nbands + 1;
+
+  std::fflush(stdout); std::fflush(stderr);
+
+  std::vector<int> fds;
+  std::vector<pid_t> pids;
+  for (int w = 0; w < nw; ++w) {
+    int sv[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) { std::perror("[DIST] socketpair"); break; }
+#if defined(SO_NOSIGPIPE)
+    for (int fd : sv) { int one = 1; ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one)); }
+#endif
+    pid_t pid = ::fork();
+    if (pid == 0) {
+      ::close(sv[0]);
+      for (int fd : fds) ::close(fd);
+      worker_main(sv[1], cfg, opt);
+    }
+    ::close(sv[1]);
+    if (pid < 0) { ::close(sv[0]); std::perror("[DIST] fork"); break; }
+    fds.push_back(sv[0]);
+    pids.push_back(pid);
+  }
+
+  struct Slot { PixelBuffer px; int left = 0; };
+  std::map<int, Slot> slots;          // frames a medio armar (<= maxbuf)
+  std::vector<PixelBuffer> pool;      // buffers de frames ya entregados
+  std::vector<int> pending(fds.size(), 0);
+  int next_frame = 0, next_band = 0, emit = 0;
+  bool ok = !fds.empty();
+
+  auto next_job = [&](JobMsg& j) {
+    if (next_frame >= opt.frames || next_frame >= emit + maxbuf) return false;
+    j = {next_frame, next_band * band, std::min(H, (next_band + 1) * band)};
+    if (next_band == 0) {
+      Slot& s = slots[next_frame];
+      if (!pool.empty()) { s.px.swap(pool.back()); pool.pop_back(); }
+      s.px.resize((size_t)W * H);
+      s.left = nbands;
+    }
+    if (++next_band == nbands) { next_band = 0; ++next_frame; }
+    return true;
+  };
+
+  auto t0 = clk::now();
+  std::vector<pollfd> pf(fds.size());
+  while (ok && emit < opt.frames) {
+    // a) repartir: uno por worker y vuelta, hasta `depth` pendientes
+    for (bool any = true; any && ok; ) {
+      any = false;
+      for (size_t w = 0; w < fds.size() && ok; ++w) {
+        if (pending[w] >= depth) continue;
+        JobMsg j;
+        if (!next_job(j)) break;
+        if (!write_all(fds[w], &j, sizeof(j))) { ok = false; break; }
+        ++pending[w]; any = true;
+      }
+    }
+    if (!ok) break;
+
+    // b) esperar filas de cualquier worker
+    for (size_t w = 0; w < fds.size(); ++w) pf[w] = {fds[w], POLLIN, 0};
+    if (::poll(pf.data(), pf.size(), -1) < 0) {
+      if (errno == EINTR) continue;
+      std::perror("[DIST] poll"); ok = false; break;
+    }
+    for (size_t w = 0; w < fds.size() && ok; ++w) {
+      if (!(pf[w].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+      JobMsg h;
+      auto it = read_all(fds[w], &h, sizeof(h)) ? slots.find(h.frame) : slots.end();
+      if (it == slots.end() || h.y0 < 0 || h.y1 > H || h.y0 >= h.y1 ||
+          !read_all(fds[w], it->second.px.data() + (size_t)h.y0 * W,
+                    (size_t)(h.y1 - h.y0) * W * sizeof(uint32_t))) {
+        std::fprintf(stderr, "[DIST] worker %zu (pid %d) failed or sent a bad reply\n",
+                     w, int(pids[w]));
+        ok = false; break;
+      }
+      --pending[w];
+      --it->second.left;
+    }
+
+    // c) entregar en orden los frames completos
+    for (auto it = slots.find(emit); it != slots.end() && it->second.left == 0;
+         it = slots.find(emit)) {
+      sink(emit, it->second.px.data());
+      pool.push_back(std::move(it->second.px));
+      slots.erase(it);
+      ++emit;
+    }
+  }
+  res.seconds = std::chrono::duration<double>(clk::now() - t0).count();
+  res.frames = emit;
+  res.ok = ok && emit == opt.frames;
+
+  // Fin: Job de salida, cerrar y recoger a los workers
+  const JobMsg stop{-1, 0, 0};
+  for (int fd : fds) { write_all(fd, &stop, sizeof(stop)); ::close(fd); }
+  for (pid_t p : pids) { int st = 0; ::waitpid(p, &st, 0); }
+  return res;
+}
+
+#else
+
+DistResult dist_render(const AppConfig&, const DistOptions&, const FrameSink&) {
+  std::fprintf(stderr, "[DIST] distributed rendering needs fork/socketpair (Unix only)\n");
+  return DistResult{};
+}
+
+#endif
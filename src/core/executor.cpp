@@ -0,0 +1,122 @@
+#include "core/executor.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#if defined(_OPENMP)
+  #include <omp.h>
+#endif
+
+void SerialExecutor::parallel_for(int n, const std::function<void(int)>& fn) {
+  for (int i = 0; i < n; ++i) fn(i);
+}
+
+void OmpExecutor::parallel_for(int n, const std::function<void(int)>& fn) {
+#if defined(_OPENMP)
+  const int nt = threads_ > 0 ? threads_ : omp_get_max_threads();
+  // Cada hilo toma índices según la política omp_set_schedule(...)
+  #pragma omp parallel for schedule(runtime) num_threads(nt)
+  for (int i = 0; i < n; ++i) fn(i);
+#else
+  for (int i = 0; i < n; ++i) fn(i);
+#endif
+}
+
+// -----------------------------------------------------
+// ThreadPoolExecutor
+// Descripción:
+//   - Los workers esperan un nuevo "gen_" (trabajo publicado) y consumen
+//     índices bajo el mutex; el hilo que llama a parallel_for también.
+//   - pending_ llega a 0 cuando terminó el último índice.
+//   - No es reentrante: un parallel_for a la vez por pool.
+// -----------------------------------------------------
+ThreadPoolExecutor::ThreadPoolExecutor(int threads) {
+  int nt = threads > 0 ? threads : (int)std::thread::hardware_concurrency();
+  nt = std::max(1, nt);
+  for (int i = 1; i < nt; ++i) workers_.emplace_back([this]{ worker_loop(); });
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor() {
+  {
+    std::lock_guard<std::mutex> lk(m_);
+    stop_ = true;
+  }
+  cv_work_.notify_all();
+  for (auto& w : workers_) w.join();
+}
+
+void ThreadPoolExecutor::drain() {
+  std::unique_lock<std::mutex> lk(m_);
+  while (next_ < n_) {
+    const int i = next_++;
+    const auto* fn = fn_;
+    lk.unlock();
+    (*fn)(i);
+    lk.lock();
+    if (--pending_ == 0) cv_done_.notify_all();
+  }
+}
+
+void ThreadPoolExecutor::worker_loop() {
+  long seen = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lk(m_);
+      cv_work_.wait(lk, [&]{ return stop_ || gen_ != seen; });
+      if (stop_) return;
+      seen = gen_;
+    }
+    drain();
+  }
+}
+
+void ThreadPoolExecutor::parallel_for(int n, const std::function<void(int)>& fn) {
+  if (n <= 0) return;
+  if (workers_.empty()) { for (int i = 0; i < n; ++i) fn(i); return; }
+  {
+    std::lock_guard<std::mutex> lk(m_);
+    fn_ = &fn; n_ = n; next_ = 0; pending_ = n; ++gen_;
+  }
+  cv_work_.notify_all();
+  drain();
+  std::unique_lock<std::mutex> lk(m_);
+  cv_done_.wait(lk, [&]{ return pending_ == 0; });
+  fn_ = nullptr; n_ = 0;
+}
+
+// -----------------------------------------------------
+// TaskExecutor::parallel_for
+// Descripción:
+//   - El estado compartido vive en un shared_ptr: una tarea que el host
+//     arranque tarde (con todo ya consumido) sólo ve next >= n y sale.
+//   - fn sólo se invoca con un índice reclamado, y parallel_for no vuelve
+//     hasta que todos terminaron, así que la referencia sigue viva.
+// -----------------------------------------------------
+void TaskExecutor::parallel_for(int n, const std::function<void(int)>& fn) {
+  if (n <= 0) return;
+  struct State {
+    std::atomic<int> next{0};
+    int n = 0, done = 0;
+    const std::function<void(int)>* fn = nullptr;
+    std::mutex m;
+    std::condition_variable cv;
+  };
+  auto st = std::make_shared<State>();
+  st->n = n; st->fn = &fn;
+
+  auto work = [st]{
+    for (;;) {
+      const int i = st->next.fetch_add(1);
+      if (i >= st->n) return;
+      (*st->fn)(i);
+      std::lock_guard<std::mutex> lk(st->m);
+      if (++st->done == st->n) st->cv.notify_all();
+    }
+  };
+  const int extra = std::min(concurrency_ - 1, n - 1);
+  for (int k = 0; k < extra; ++k) submit_(work);
+  work();
+
+  std::unique_lock<std::mutex> lk(st->m);
+  st->cv.wait(lk, [&]{ return st->done == st->n; });
+}
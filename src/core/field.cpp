@@ -1,10 +1,13 @@
 #include "core/field.hpp"
+#include "core/internal.hpp"
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 
 // -------------------- Helpers de color (HSL) --------------------
-static void rgb_to_hsl(uint8_t R, uint8_t G, uint8_t B, float& h, float& s, float& l) {
+namespace detail {
+void rgb_to_hsl(uint8_t R, uint8_t G, uint8_t B, float& h, float& s, float& l) {
   float r = R / 255.f, g = G / 255.f, b = B / 255.f;
   float mx = std::max(r, std::max(g, b));
   float mn = std::min(r, std::min(g, b));
@@ -24,7 +27,7 @@ static float hlerp(float p, float q, float t) {
   if (t < 2.f/3.f) return p + (q - p) * (2.f/3.f - t) * 6.f;
   return p;
 }
-static void hsl_to_rgb(float h, float s, float l, uint8_t& R, uint8_t& G, uint8_t& B) {
+void hsl_to_rgb(float h, float s, float l, uint8_t& R, uint8_t& G, uint8_t& B) {
   h = std::fmod(h < 0 ? h + 360.f : h, 360.f);
   float H = h / 360.f;
   float q = l < 0.5f ? l * (1.f + s) : l + s - l * s;
@@ -36,13 +39,30 @@ static void hsl_to_rgb(float h, float s, float l, uint8_t& R, uint8_t& G, uint8_
   G = uint8_t(std::clamp(g, 0.f, 1.f) * 255.f);
   B = uint8_t(std::clamp(b, 0.f, 1.f) * 255.f);
 }
+} // namespace detail
+using detail::rgb_to_hsl;
+using detail::hsl_to_rgb;
 
 // -------------------- NebulaField --------------------
+// Ganancia del warp con --noise gradient: iguala la desviación estándar del
+// offset del value noise en [-1,1] (~0.40) con la de dN/dx (~0.70)
+static constexpr float kCurlGain = 0.57f;
+
 NebulaField::NebulaField(const AppConfig& cfg) : cfg_(cfg) {
+  gradient_ = (cfg_.noise == "gradient");
+  if (cfg_.noise == "volume") {
+    // Lattice periódico: mismos valores que hash_u32 dentro de [0,N)^3
+    vol_ = std::make_shared<const NoiseVolume>(
+      cfg_.seed, cfg_.noise_vol, cfg_.noise_cache,
+      [this](int i, int j, int k) { return lattice_u16(i, j, k); });
+  }
+
   // Genera dos colores extremos pseudoaleatorios a partir de --seed
   // (usamos hash_u32 para derivar bytes; si quieres evitar tonos muy oscuros,
   // levantamos un poco los mínimos con un offset)
-  uint64_t now = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+  // --deterministic: paleta sólo a partir de la seed (misma imagen en cada run)
+  uint64_t now = cfg_.deterministic ? 0
+               : std::chrono::high_resolution_clock::now().time_since_epoch().count();
   uint32_t h1 = hash_u32(uint32_t(now ^ (cfg_.seed * 1234u)));
   uint32_t h2 = hash_u32(uint32_t((now >> 32) ^ (cfg_.seed * 5678u)));
 
@@ -79,19 +99,31 @@ uint32_t NebulaField::hash_u32(uint32_t x) const {
   return x;
 }
 
+// Hash del nodo (xi,yi,zi) del lattice: value noise usa los 16 bits bajos,
+// gradient noise los bits 16..19 (índice de gradiente)
+uint32_t NebulaField::lattice_hash(int xi, int yi, int zi) const {
+  return hash_u32(
+    uint32_t(xi) * 73856093u ^
+    uint32_t(yi) * 19349663u ^
+    uint32_t(zi) * 83492791u
+  );
+}
+
+// Valor del nodo (xi,yi,zi) del lattice (16 bits del hash)
+uint16_t NebulaField::lattice_u16(int xi, int yi, int zi) const {
+  return uint16_t(lattice_hash(xi, yi, zi) & 0xFFFF);
+}
+
 // Value noise 3D + trilineal
 float NebulaField::noise3(float x, float y, float z) const {
+  if (vol_) return vnoise3(x, y, z);
+
   int xi = int(std::floor(x)), yi = int(std::floor(y)), zi = int(std::floor(z));
   float xf = x - xi, yf = y - yi, zf = z - zi;
   float u = smooth(xf), v = smooth(yf), w = smooth(zf);
 
   auto cell = [&](int dx, int dy, int dz) {
-    uint32_t h = hash_u32(
-      uint32_t(xi + dx) * 73856093u ^
-      uint32_t(yi + dy) * 19349663u ^
-      uint32_t(zi + dz) * 83492791u
-    );
-    return (h & 0xFFFF) / 65535.f; // [0,1]
+    return lattice_u16(xi + dx, yi + dy, zi + dz) / 65535.f; // [0,1]
   };
 
   float c000 = cell(0,0,0), c100 = cell(1,0,0), c010 = cell(0,1,0), c110 = cell(1,1,0);
@@ -108,6 +140,80 @@ float NebulaField::noise3(float x, float y, float z) const {
   return lerp(y0, y1, w); // [0,1]
 }
 
+// Igual que noise3 pero leyendo los nodos del volumen periódico (sin hash).
+// Las octavas escalan coordenadas y el wrap lo resuelve NoiseVolume::at.
+float NebulaField::vnoise3(float x, float y, float z) const {
+  int xi = int(std::floor(x)), yi = int(std::floor(y)), zi = int(std::floor(z));
+  float xf = x - xi, yf = y - yi, zf = z - zi;
+  float u = smooth(xf), v = smooth(yf), w = smooth(zf);
+
+  const NoiseVolume& V = *vol_;
+  auto cell = [&](int dx, int dy, int dz) {
+    return V.at(xi + dx, yi + dy, zi + dz) * (1.f / 65535.f);
+  };
+
+  float x00 = lerp(cell(0,0,0), cell(1,0,0), u);
+  float x10 = lerp(cell(0,1,0), cell(1,1,0), u);
+  float x01 = lerp(cell(0,0,1), cell(1,0,1), u);
+  float x11 = lerp(cell(0,1,1), cell(1,1,1), u);
+
+  return lerp(lerp(x00, x10, v), lerp(x01, x11, v), w); // [0,1]
+}
+
+// Gradient noise 3D (Perlin) con derivadas analíticas.
+// Una sola evaluación devuelve el valor y dN/dx, dN/dy, dN/dz, así el warp
+// no necesita taps extra de noise3 para obtener un desplazamiento 2D.
+NebulaField::NoiseD NebulaField::gnoise3(float x, float y, float z) const {
+  // 12 direcciones de arista del cubo (+4 repetidas para indexar con 4 bits)
+  static const float G[16][3] = {
+    { 1, 1, 0},{-1, 1, 0},{ 1,-1, 0},{-1,-1, 0},
+    { 1, 0, 1},{-1, 0, 1},{ 1, 0,-1},{-1, 0,-1},
+    { 0, 1, 1},{ 0,-1, 1},{ 0, 1,-1},{ 0,-1,-1},
+    { 1, 1, 0},{-1, 1, 0},{ 0,-1, 1},{ 0,-1,-1}
+  };
+
+  int xi = int(std::floor(x)), yi = int(std::floor(y)), zi = int(std::floor(z));
+  float xf = x - xi, yf = y - yi, zf = z - zi;
+  float u = smooth(xf), v = smooth(yf), w = smooth(zf);
+  // derivada de smootherstep: 30x^2 (x-1)^2
+  float du = 30.f*xf*xf*(xf*(xf - 2.f) + 1.f);
+  float dv = 30.f*yf*yf*(yf*(yf - 2.f) + 1.f);
+  float dw = 30.f*zf*zf*(zf*(zf - 2.f) + 1.f);
+
+  auto grad = [&](int dx, int dy, int dz) {
+    return G[(lattice_hash(xi + dx, yi + dy, zi + dz) >> 16) & 15];
+  };
+  const float *ga = grad(0,0,0), *gb = grad(1,0,0), *gc = grad(0,1,0), *gd = grad(1,1,0);
+  const float *ge = grad(0,0,1), *gf = grad(1,0,1), *gg = grad(0,1,1), *gh = grad(1,1,1);
+
+  // Proyección de cada gradiente sobre el vector esquina->punto
+  auto dot = [&](const float* g, float ox, float oy, float oz) {
+    return g[0]*(xf - ox) + g[1]*(yf - oy) + g[2]*(zf - oz);
+  };
+  float va = dot(ga,0,0,0), vb = dot(gb,1,0,0), vc = dot(gc,0,1,0), vd = dot(gd,1,1,0);
+  float ve = dot(ge,0,0,1), vf = dot(gf,1,0,1), vg = dot(gg,0,1,1), vh = dot(gh,1,1,1);
+
+  // Interpolación trilineal expandida en polinomio (k1..k7) para derivar
+  float k1 = vb - va, k2 = vc - va, k3 = ve - va;
+  float k4 = va - vb - vc + vd, k5 = va - vc - ve + vg, k6 = va - vb - ve + vf;
+  float k7 = -va + vb + vc - vd + ve - vf - vg + vh;
+  float uv = u*v, vw = v*w, wu = w*u;
+
+  NoiseD n;
+  n.v = va + u*k1 + v*k2 + w*k3 + uv*k4 + vw*k5 + wu*k6 + uv*w*k7;
+
+  // Derivada = gradientes interpolados (trilineal) + término del fade
+  auto tri = [&](int i) {
+    float x00 = lerp(ga[i], gb[i], u), x10 = lerp(gc[i], gd[i], u);
+    float x01 = lerp(ge[i], gf[i], u), x11 = lerp(gg[i], gh[i], u);
+    return lerp(lerp(x00, x10, v), lerp(x01, x11, v), w);
+  };
+  n.dx = tri(0) + du*(k1 + v*k4 + w*k6 + vw*k7);
+  n.dy = tri(1) + dv*(k2 + w*k5 + u*k4 + wu*k7);
+  n.dz = tri(2) + dw*(k3 + u*k6 + v*k5 + uv*k7);
+  return n;
+}
+
 // fBm clásico (suma de ruidos a distintas escalas)
 float NebulaField::fbm(float x, float y, float z, int octaves) const {
   float amp = 1.f, freq = 1.f;
@@ -163,6 +269,33 @@ void NebulaField::palette_bw(float v, uint8_t& r, uint8_t& g, uint8_t& b) const
   r = g = b = k;
 }
 
+// Etapa de color: paleta aleatoria por seed + boost de saturación + rotación de tono
+void NebulaField::color_stage(float shade, float t, uint8_t& r, uint8_t& g, uint8_t& b) const {
+  // -------- Paleta ALEATORIA por seed (sin paletas predefinidas) --------
+  r = uint8_t(baseR1 * (1.0f - shade) + baseR2 * shade);
+  g = uint8_t(baseG1 * (1.0f - shade) + baseG2 * shade);
+  b = uint8_t(baseB1 * (1.0f - shade) + baseB2 * shade);
+
+  // Aumentar saturación para que no se vean grises
+  float h,s,l;
+  rgb_to_hsl(r,g,b,h,s,l);
+  s = std::min(1.f, s * 1.4f);  // boost
+  hsl_to_rgb(h,s,l,r,g,b);
+  // Rotación de tono (hue) dependiente de seed + animación suave en el tiempo
+  {
+    float h, s, l;
+    rgb_to_hsl(r, g, b, h, s, l);
+    float base_h = float(cfg_.seed % 360);       // depende de --seed
+    float anim_h = 35.f * cfg_.drift * std::sin(t * 0.17f); // oscilación suave
+    h = h + base_h * 0.25f + anim_h;
+    hsl_to_rgb(h, s, l, r, g, b);
+  }
+}
+
+bool NebulaField::is_static() const {
+  return cfg_.zspeed == 0.f && cfg_.drift == 0.f && !cfg_.stars;
+}
+
 // Pixel final (warp + swirl + filamentos + estrellas + viñeta + paleta aleatoria)
 uint32_t NebulaField::sample_pixel(int x, int y, float t) const {
   // Coordenadas normalizadas y centradas
@@ -173,17 +306,26 @@ uint32_t NebulaField::sample_pixel(int x, int y, float t) const {
   float z  = t * cfg_.zspeed;
 
   // Domain warp (turbulencia)
-  float w1x = (noise3(sx*0.9f + 2.1f, sy*0.9f,       z*0.6f) * 2.f - 1.f);
-  float w1y = (noise3(sx*0.9f,       sy*0.9f + 3.7f, z*0.6f) * 2.f - 1.f);
-  float w2x = (noise3(sx*1.7f + 5.3f, sy*1.7f,       z*1.1f) * 2.f - 1.f);
-  float w2y = (noise3(sx*1.7f,       sy*1.7f + 4.2f, z*1.1f) * 2.f - 1.f);
+  float w1x, w1y, w2x, w2y;
+  if (gradient_) {
+    // Curl 2D del gradiente (dN/dy, -dN/dx): 2 evaluaciones en vez de 4 taps
+    NoiseD n1 = gnoise3(sx*0.9f + 2.1f, sy*0.9f, z*0.6f);
+    NoiseD n2 = gnoise3(sx*1.7f + 5.3f, sy*1.7f, z*1.1f);
+    w1x =  n1.dy * kCurlGain;  w1y = -n1.dx * kCurlGain;
+    w2x =  n2.dy * kCurlGain;  w2y = -n2.dx * kCurlGain;
+  } else {
+    w1x = (noise3(sx*0.9f + 2.1f, sy*0.9f,       z*0.6f) * 2.f - 1.f);
+    w1y = (noise3(sx*0.9f,       sy*0.9f + 3.7f, z*0.6f) * 2.f - 1.f);
+    w2x = (noise3(sx*1.7f + 5.3f, sy*1.7f,       z*1.1f) * 2.f - 1.f);
+    w2y = (noise3(sx*1.7f,       sy*1.7f + 4.2f, z*1.1f) * 2.f - 1.f);
+  }
   float warp1 = 0.42f, warp2 = 0.18f;
   float wx = sx + w1x * warp1 + w2x * warp2;
   float wy = sy + w1y * warp1 + w2y * warp2;
 
   // Swirl (remolino) dependiente del radio + leve spin temporal
   float r2 = wx*wx + wy*wy;
-  float ang = 0.65f * (1.f - std::exp(-r2 * 0.9f)) + 0.18f * t;
+  float ang = 0.65f * (1.f - std::exp(-r2 * 0.9f)) + 0.18f * cfg_.drift * t;
   float cs = std::cos(ang), sn = std::sin(ang);
   float rx =  cs * wx - sn * wy;
   float ry =  sn * wx + cs * wy;
@@ -202,27 +344,11 @@ uint32_t NebulaField::sample_pixel(int x, int y, float t) const {
   shade = std::clamp(shade + core, 0.f, 1.f);
   shade = std::pow(shade, 1.4f);
 
-  // -------- Paleta ALEATORIA por seed (sin paletas predefinidas) --------
-  uint8_t r = uint8_t(baseR1 * (1.0f - shade) + baseR2 * shade);
-  uint8_t g = uint8_t(baseG1 * (1.0f - shade) + baseG2 * shade);
-  uint8_t b = uint8_t(baseB1 * (1.0f - shade) + baseB2 * shade);
-
-  // Aumentar saturación para que no se vean grises
-  float h,s,l;
-  rgb_to_hsl(r,g,b,h,s,l);
-  s = std::min(1.f, s * 1.4f);  // boost
-  hsl_to_rgb(h,s,l,r,g,b);
-  // Rotación de tono (hue) dependiente de seed + animación suave en el tiempo
-  {
-    float h, s, l;
-    rgb_to_hsl(r, g, b, h, s, l);
-    float base_h = float(cfg_.seed % 360);       // depende de --seed
-    float anim_h = 35.f * std::sin(t * 0.17f);   // oscilación suave
-    h = h + base_h * 0.25f + anim_h;
-    hsl_to_rgb(h, s, l, r, g, b);
-  }
+  uint8_t r, g, b;
+  color_stage(shade, t, r, g, b);
 
   // Estrellas con parpadeo (pocas, mezcla aditiva)
+  if (!cfg_.stars) return pack_rgba(r, g, b, 255);
   uint32_t hh = hash_u32(uint32_t(x) * 2654435761u ^ uint32_t(y) * 1013904223u);
   float rnd = (hh & 0xFFFFFF) / float(0xFFFFFF);
   if (rnd > 0.9980f) { // ~0.2%
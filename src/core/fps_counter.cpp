@@ -7,11 +7,13 @@ using clk = std::chrono::steady_clock; // alias para el reloj estable de alta pr
 //   - Incrementa el número de frames renderizados.
 //   - Cada 500 ms calcula la media de FPS.
 //   - Reinicia el contador de frames para el siguiente período.
+//   - Devuelve true en los frames en que se actualizó el valor
+//     (el HUD lo usa para no re-rasterizar texto sin cambios).
 // Notas:
 //   - Se usa un promedio en 0.5s porque da un balance entre
 //     respuesta rápida y estabilidad en el valor mostrado.
 // -----------------------------------------------------
-void FPSCounter::tick() {
+bool FPSCounter::tick() {
   frames_++; // contar un frame más
 
   auto now = clk::now(); // obtener tiempo actual
@@ -22,5 +24,7 @@ void FPSCounter::tick() {
     fps_ = frames_ * 1000.0 / ms; // frames renderizados por segundo
     frames_ = 0;                  // reiniciar contador
     last_ = now;                  // actualizar última medición
+    return true;
   }
+  return false;
 }
\ No newline at end of file
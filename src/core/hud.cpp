@@ -0,0 +1,166 @@
+#include "core/hud.hpp"
+#include <algorithm>
+
+#if defined(__SSE2__)
+  #include <emmintrin.h> // mezcla alpha entera del HUD
+#endif
+
+namespace hud {
+
+// 5x7 (bitmask por fila). Cada byte codifica 5 bits útiles.
+static const Glyph G0{{0x1E,0x11,0x13,0x15,0x19,0x11,0x1E}};
+static const Glyph G1{{0x04,0x0C,0x14,0x04,0x04,0x04,0x1F}};
+static const Glyph G2{{0x1E,0x01,0x01,0x1E,0x10,0x10,0x1F}};
+static const Glyph G3{{0x1E,0x01,0x01,0x0E,0x01,0x01,0x1E}};
+static const Glyph G4{{0x02,0x06,0x0A,0x12,0x1F,0x02,0x02}};
+static const Glyph G5{{0x1F,0x10,0x10,0x1E,0x01,0x01,0x1E}};
+static const Glyph G6{{0x0E,0x10,0x10,0x1E,0x11,0x11,0x0E}};
+static const Glyph G7{{0x1F,0x01,0x02,0x04,0x08,0x08,0x08}};
+static const Glyph G8{{0x0E,0x11,0x11,0x0E,0x11,0x11,0x0E}};
+static const Glyph G9{{0x0E,0x11,0x11,0x0F,0x01,0x01,0x0E}};
+static const Glyph SP{{0x00,0x00,0x00,0x00,0x00,0x00,0x00}};
+static const Glyph DOT{{0x00,0x00,0x00,0x00,0x00,0x06,0x06}};
+static const Glyph EQ{{0x00,0x00,0x1F,0x00,0x1F,0x00,0x00}};  // =
+static const Glyph COL{{0x00,0x06,0x06,0x00,0x06,0x06,0x00}}; // :
+static const Glyph DASH{{0x00,0x00,0x00,0x1F,0x00,0x00,0x00}};// -
+static const Glyph SLASH{{0x01,0x01,0x02,0x04,0x08,0x10,0x10}};// /
+static const Glyph PCT{{0x18,0x19,0x02,0x04,0x08,0x13,0x03}}; // %
+// A-Z (las minúsculas se dibujan con la mayúscula)
+static const Glyph AZ[26]{
+  {{0x0E,0x11,0x11,0x1F,0x11,0x11,0x11}}, // A
+  {{0x1E,0x11,0x11,0x1E,0x11,0x11,0x1E}}, // B
+  {{0x0E,0x11,0x10,0x10,0x10,0x11,0x0E}}, // C
+  {{0x1E,0x11,0x11,0x11,0x11,0x11,0x1E}}, // D
+  {{0x1F,0x10,0x10,0x1E,0x10,0x10,0x1F}}, // E
+  {{0x1F,0x10,0x10,0x1E,0x10,0x10,0x10}}, // F
+  {{0x0E,0x11,0x10,0x17,0x11,0x11,0x0F}}, // G
+  {{0x11,0x11,0x11,0x1F,0x11,0x11,0x11}}, // H
+  {{0x0E,0x04,0x04,0x04,0x04,0x04,0x0E}}, // I
+  {{0x07,0x02,0x02,0x02,0x02,0x12,0x0C}}, // J
+  {{0x11,0x12,0x14,0x18,0x14,0x12,0x11}}, // K
+  {{0x10,0x10,0x10,0x10,0x10,0x10,0x1F}}, // L
+  {{0x11,0x1B,0x15,0x15,0x11,0x11,0x11}}, // M
+  {{0x11,0x11,0x19,0x15,0x13,0x11,0x11}}, // N
+  {{0x0E,0x11,0x11,0x11,0x11,0x11,0x0E}}, // O
+  {{0x1E,0x11,0x11,0x1E,0x10,0x10,0x10}}, // P
+  {{0x0E,0x11,0x11,0x11,0x15,0x12,0x0D}}, // Q
+  {{0x1E,0x11,0x11,0x1E,0x14,0x12,0x11}}, // R
+  {{0x0F,0x10,0x10,0x0E,0x01,0x01,0x1E}}, // S
+  {{0x1F,0x04,0x04,0x04,0x04,0x04,0x04}}, // T
+  {{0x11,0x11,0x11,0x11,0x11,0x11,0x0E}}, // U
+  {{0x11,0x11,0x11,0x11,0x11,0x0A,0x04}}, // V
+  {{0x11,0x11,0x11,0x15,0x15,0x15,0x0A}}, // W
+  {{0x11,0x0A,0x04,0x04,0x0A,0x11,0x11}}, // X
+  {{0x11,0x11,0x0A,0x04,0x04,0x04,0x04}}, // Y
+  {{0x1F,0x01,0x02,0x04,0x08,0x10,0x1F}}, // Z
+};
+
+// Devuelve el glyph para el caracter solicitado.
+const Glyph* get(char c){
+  if(c>='a' && c<='z') c=char(c-'a'+'A');
+  if(c>='A' && c<='Z') return &AZ[c-'A'];
+  switch(c){
+    case '0':return &G0; case '1':return &G1; case '2':return &G2; case '3':return &G3; case '4':return &G4;
+    case '5':return &G5; case '6':return &G6; case '7':return &G7; case '8':return &G8; case '9':return &G9;
+    case ' ':return &SP; case '.':return &DOT; case '=':return &EQ; case ':':return &COL; case '-':return &DASH;
+    case '/':return &SLASH; case '%':return &PCT; default:return &SP;
+  }
+}
+
+// x*a/255 con redondeo, sólo enteros (exacto para 0..255*255)
+static inline uint32_t mul255(uint32_t x, uint32_t a){
+  uint32_t v=x*a+128; return (v+(v>>8))>>8;
+}
+
+// "src over dst" con src ARGB premultiplicado y dst opaco
+uint32_t over_premul(uint32_t dst, uint32_t src){
+  uint32_t ia=255-(src>>24);
+  uint32_t r=((src>>16)&0xFF)+mul255((dst>>16)&0xFF,ia);
+  uint32_t g=((src>> 8)&0xFF)+mul255((dst>> 8)&0xFF,ia);
+  uint32_t b=( src     &0xFF)+mul255( dst     &0xFF,ia);
+  return 0xFF000000u | (std::min(r,255u)<<16) | (std::min(g,255u)<<8) | std::min(b,255u);
+}
+
+void Overlay::build_atlas(int s){
+  scale_=s; cw_=5*s+1; ch_=7*s+1;
+  atlas_.assign((size_t)128*cw_*ch_,0u);
+  for(int c=0; c<128; ++c){
+    const Glyph* g=get(char(c));
+    uint32_t* cell=atlas_.data()+(size_t)c*cw_*ch_;
+    // Sombra (negro opaco, desplazada 1px) y luego el texto (blanco)
+    for(int pass=0; pass<2; ++pass){
+      const int off=(pass==0)?1:0;
+      const uint32_t col=(pass==0)?0xFF000000u:0xFFFFFFFFu;
+      for(int ry=0; ry<7; ++ry)
+        for(int rx=0; rx<5; ++rx){
+          if(((g->rows[ry]>>(4-rx))&1)==0) continue;
+          for(int dy=0; dy<s; ++dy)
+            for(int dx=0; dx<s; ++dx)
+              cell[(ry*s+dy+off)*cw_+rx*s+dx+off]=col;
+        }
+    }
+  }
+}
+
+bool Overlay::update(const std::string& text,int s){
+  if(text==text_ && s==scale_) return false;
+  if(s!=scale_) build_atlas(s);
+  text_=text;
+
+  // Medidas: líneas separadas por '\n', caja con margen de 7px
+  int cols=0, lines=1, cur=0;
+  for(char c: text){ if(c=='\n'){ ++lines; cur=0; } else cols=std::max(cols,++cur); }
+  const int adv=6*s, lh=8*s+2;
+  w_=cols*adv+14; h_=lines*lh-(lh-7*s)+14;
+  // Caja semitransparente (0x66000000 premultiplicado = mismo valor)
+  px_.assign((size_t)w_*h_,0x66000000u);
+
+  int cx=7, cy=7;
+  for(char c: text){
+    if(c=='\n'){ cx=7; cy+=lh; continue; }
+    const uint32_t* cell=atlas_.data()+glyph_index(c)*cw_*ch_;
+    for(int y=0; y<ch_ && cy+y<h_; ++y){
+      uint32_t* dst=px_.data()+(size_t)(cy+y)*w_+cx;
+      const uint32_t* src=cell+y*cw_;
+      for(int x=0; x<cw_ && cx+x<w_; ++x)
+        if(src[x]) dst[x]=src[x]; // sombra/texto opacos sustituyen a la caja
+    }
+    cx+=adv;
+  }
+  return true;
+}
+
+void Overlay::blend_span(uint32_t* d,int fx0,int fx1,int fy,int x,int y) const {
+  if(fy<y || fy>=y+h_) return;
+  const int x1=std::max(fx0,x), x2=std::min(fx1,x+w_);
+  if(x1>=x2) return;
+  d+=x1-fx0;
+  const uint32_t* o=px_.data()+(size_t)(fy-y)*w_+(x1-x);
+  int n=x2-x1, i=0;
+#if defined(__SSE2__)
+  const __m128i k128=_mm_set1_epi16(128), zero=_mm_setzero_si128();
+  const __m128i kA=_mm_set1_epi32((int)0xFF000000u);
+  for(; i+4<=n; i+=4){
+    __m128i sv=_mm_loadu_si128((const __m128i*)(o+i));
+    __m128i dv=_mm_loadu_si128((const __m128i*)(d+i));
+    // 255-alpha replicado en los 4 canales de cada pixel (16 bits)
+    __m128i ia=_mm_sub_epi32(_mm_set1_epi32(255),_mm_srli_epi32(sv,24));
+    ia=_mm_or_si128(ia,_mm_slli_epi32(ia,16));
+    __m128i ialo=_mm_unpacklo_epi32(ia,ia), iahi=_mm_unpackhi_epi32(ia,ia);
+    __m128i lo=_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(dv,zero),ialo),k128);
+    __m128i hi=_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(dv,zero),iahi),k128);
+    lo=_mm_srli_epi16(_mm_add_epi16(lo,_mm_srli_epi16(lo,8)),8);
+    hi=_mm_srli_epi16(_mm_add_epi16(hi,_mm_srli_epi16(hi,8)),8);
+    __m128i r=_mm_adds_epu8(_mm_packus_epi16(lo,hi),sv);
+    _mm_storeu_si128((__m128i*)(d+i),_mm_or_si128(r,kA));
+  }
+#endif
+  for(; i<n; ++i) d[i]=over_premul(d[i],o[i]);
+}
+
+void Overlay::composite(uint32_t* pix,size_t stride,int W,int H,int x,int y) const {
+  for(int yy=std::max(0,y); yy<std::min(H,y+h_); ++yy)
+    blend_span((uint32_t*)((uint8_t*)pix+(size_t)yy*stride),0,W,yy,x,y);
+}
+
+} // namespace hud
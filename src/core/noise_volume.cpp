@@ -0,0 +1,121 @@
+#include "core/noise_volume.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+  #define NOISE_VOLUME_MMAP 1
+#endif
+
+// Cabecera del archivo de cache (seguida de N^3 uint16 en orden z,y,x)
+struct VolumeHeader {
+  char     magic[8];   // "NBVOL01"
+  uint32_t seed;
+  uint32_t size;
+};
+static const char kMagic[8] = "NBVOL01";
+
+// -----------------------------------------------------
+// NoiseVolume
+// Descripción:
+//   - Si hay cache_dir, intenta mapear "<dir>/nebula_noise_s<seed>_n<N>.vol".
+//   - Si no existe (o no coincide), construye el volumen en paralelo y lo
+//     guarda (escritura en .tmp + rename, para no dejar archivos a medias).
+// -----------------------------------------------------
+NoiseVolume::NoiseVolume(uint32_t seed, int size, const std::string& cache_dir,
+                         const LatticeFn& lattice)
+  : n_(size), mask_(size - 1) {
+  using clk = std::chrono::steady_clock;
+  auto t0 = clk::now();
+
+  std::string path;
+  if (!cache_dir.empty()) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "/nebula_noise_s%u_n%d.vol", seed, size);
+    path = cache_dir + name;
+    from_cache_ = load_cache(path, seed);
+  }
+  if (!from_cache_) {
+    build(lattice);
+    if (!path.empty()) save_cache(path, seed);
+  }
+
+  startup_ms_ = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+  std::printf("[NOISE] volume %d^3 %s in %.2f ms%s%s\n", n_,
+              from_cache_ ? "mapped" : "built", startup_ms_,
+              path.empty() ? "" : " cache=", path.c_str());
+  std::fflush(stdout);
+}
+
+NoiseVolume::~NoiseVolume() {
+#if defined(NOISE_VOLUME_MMAP)
+  if (map_) munmap(map_, map_bytes_);
+#endif
+}
+
+// Construcción paralela: cada plano z es independiente
+void NoiseVolume::build(const LatticeFn& lattice) {
+  const int N = n_;
+  owned_.assign(size_t(N) * N * N, 0);
+  uint16_t* out = owned_.data();
+  #pragma omp parallel for schedule(static)
+  for (int z = 0; z < N; ++z)
+    for (int y = 0; y < N; ++y)
+      for (int x = 0; x < N; ++x)
+        out[(size_t(z) * N + y) * N + x] = lattice(x, y, z);
+  data_ = out;
+}
+
+bool NoiseVolume::load_cache(const std::string& path, uint32_t seed) {
+#if defined(NOISE_VOLUME_MMAP)
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  const size_t expect = sizeof(VolumeHeader) + size_t(n_) * n_ * n_ * sizeof(uint16_t);
+  struct stat st{};
+  if (fstat(fd, &st) != 0 || size_t(st.st_size) != expect) { close(fd); return false; }
+  void* m = mmap(nullptr, expect, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (m == MAP_FAILED) return false;
+
+  const VolumeHeader* h = static_cast<const VolumeHeader*>(m);
+  if (std::memcmp(h->magic, kMagic, sizeof(kMagic)) != 0 ||
+      h->seed != seed || h->size != uint32_t(n_)) {
+    std::fprintf(stderr, "[warn] stale noise cache '%s' -> rebuilding\n", path.c_str());
+    munmap(m, expect);
+    return false;
+  }
+  map_ = m; map_bytes_ = expect;
+  data_ = reinterpret_cast<const uint16_t*>(static_cast<const char*>(m) + sizeof(VolumeHeader));
+  return true;
+#else
+  (void)path; (void)seed;
+  return false;
+#endif
+}
+
+void NoiseVolume::save_cache(const std::string& path, uint32_t seed) const {
+#if defined(NOISE_VOLUME_MMAP)
+  std::string tmp = path + ".tmp." + std::to_string(getpid());
+  FILE* f = std::fopen(tmp.c_str(), "wb");
+  if (!f) {
+    std::fprintf(stderr, "[warn] cannot write noise cache '%s'\n", tmp.c_str());
+    return;
+  }
+  VolumeHeader h{};
+  std::memcpy(h.magic, kMagic, sizeof(kMagic));
+  h.seed = seed; h.size = uint32_t(n_);
+  bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1 &&
+            std::fwrite(owned_.data(), sizeof(uint16_t), owned_.size(), f) == owned_.size();
+  ok = (std::fclose(f) == 0) && ok;
+  if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+    std::fprintf(stderr, "[warn] cannot write noise cache '%s'\n", path.c_str());
+    std::remove(tmp.c_str());
+  }
+#else
+  (void)path; (void)seed;
+#endif
+}
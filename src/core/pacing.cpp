@@ -0,0 +1,61 @@
+#include "core/pacing.hpp"
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <unistd.h>
+#endif
+
+FramePacer::FramePacer(double fps_cap) {
+  if (fps_cap > 0.0)
+    period_ = std::chrono::duration_cast<clk::duration>(std::chrono::duration<double>(1.0 / fps_cap));
+}
+
+// -----------------------------------------------------
+// FramePacer::wait
+// Descripción:
+//   - Avanza el deadline un período y duerme hasta ~0.3 ms antes.
+//   - El resto se completa con yield (el sleep del SO no es preciso).
+//   - Si vamos más de un período tarde, se resincroniza en vez de
+//     encadenar frames sin pausa para "recuperar".
+// -----------------------------------------------------
+void FramePacer::wait() {
+  if (!enabled()) return;
+  deadline_ += period_;
+  auto now = clk::now();
+  if (now > deadline_ + period_) { deadline_ = now; return; }
+
+  const auto slack = std::chrono::microseconds(300);
+  if (deadline_ - now > slack) std::this_thread::sleep_until(deadline_ - slack);
+  while (clk::now() < deadline_) std::this_thread::yield();
+}
+
+double process_cpu_seconds() {
+#if defined(CLOCK_PROCESS_CPUTIME_ID)
+  timespec ts{};
+  if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) == 0)
+    return double(ts.tv_sec) + ts.tv_nsec * 1e-9;
+#endif
+  return double(std::clock()) / CLOCKS_PER_SEC;
+}
+
+void apply_omp_wait_policy(const std::string& policy, char** argv) {
+  if (policy != "active" && policy != "passive") return;
+  const char* want = (policy == "passive") ? "PASSIVE" : "ACTIVE";
+  std::string cur = std::getenv("OMP_WAIT_POLICY") ? std::getenv("OMP_WAIT_POLICY") : "";
+  for (char &ch : cur)
+    ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+  if (cur == want) return; // ya aplicado
+
+#if defined(__linux__)
+  setenv("OMP_WAIT_POLICY", want, 1);
+  std::fflush(stdout);
+  execv("/proc/self/exe", argv);
+  std::fprintf(stderr, "[warn] cannot re-exec for OMP_WAIT_POLICY=%s; export it manually\n", want);
+#else
+  std::fprintf(stderr, "[warn] --wait-policy needs OMP_WAIT_POLICY=%s exported before launch\n", want);
+#endif
+}
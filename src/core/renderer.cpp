@@ -0,0 +1,234 @@
+#include "core/renderer.hpp"
+#include "core/hud.hpp"
+#include "core/internal.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(_OPENMP)
+  #include <omp.h>
+#endif
+#if defined(__SSE2__)
+  #include <emmintrin.h> // _mm_stream_si128 / _mm_sfence
+#endif
+#if defined(__unix__)
+  #include <unistd.h>
+#endif
+
+size_t llc_bytes(){
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+  long l3=sysconf(_SC_LEVEL3_CACHE_SIZE);
+  if(l3>0) return (size_t)l3;
+  long l2=sysconf(_SC_LEVEL2_CACHE_SIZE);
+  if(l2>0) return (size_t)l2;
+#endif
+  return (size_t)16<<20;
+}
+
+RenderParams render_params_from(const AppConfig& cfg, bool use_omp) {
+  RenderParams rp;
+  rp.use_omp = use_omp;
+  rp.scale = std::clamp(cfg.render_scale, 0.3f, 1.0f);
+
+  // Tamaño de tile (usamos chunk como guía; clamp para cache-friendliness)
+  int TS = (cfg.omp_chunk>0 ? cfg.omp_chunk : 32);
+  TS = std::max(8, std::min(64, TS));
+  rp.tile_w = cfg.tile_w > 0 ? cfg.tile_w : TS;
+  rp.tile_h = cfg.tile_h > 0 ? cfg.tile_h : TS;
+
+  // Non-temporal sólo compensa si el frame no cabe en la LLC: si cabe, la
+  // copia/upload siguiente lo lee de cache
+  const size_t frame_bytes=(size_t)cfg.width*cfg.height*sizeof(uint32_t);
+  rp.stream = cfg.stream=="on" || (cfg.stream=="auto" && frame_bytes > llc_bytes());
+  return rp;
+}
+
+void apply_omp_runtime(const std::string& schedule, int chunk, int threads) {
+#if defined(_OPENMP)
+  omp_sched_t kind=omp_sched_static;
+  if      (schedule=="dynamic") kind=omp_sched_dynamic;
+  else if (schedule=="guided")  kind=omp_sched_guided;
+  else if (schedule=="auto")    kind=omp_sched_auto;
+  omp_set_schedule(kind,chunk);
+  if(threads>0) omp_set_num_threads(threads);
+#else
+  (void)schedule; (void)chunk; (void)threads;
+#endif
+}
+
+namespace detail {
+// Expande (nearest) una fila reducida a las columnas de salida [x0,x1):
+// dst[x-x0] = src[sx(x)-sxbase], con sx(x) = min(SW-1, x*s)
+void upscale_row(uint32_t* dst, const uint32_t* src, int x0, int x1, int sxbase, float s, int SW){
+  #pragma omp simd
+  for(int x=x0; x<x1; ++x) dst[x-x0]=src[std::min(SW-1,(int)(x*s))-sxbase];
+}
+
+// Copia fila a fila a un destino con pitch (p.ej. textura SDL bloqueada)
+void copy_rows(void* dst, int pitch, const uint32_t* src, int W, int H, bool stream){
+  for(int y=0;y<H;++y){
+    uint32_t* d=(uint32_t*)((uint8_t*)dst + (size_t)y*pitch);
+    if(stream) stream_row(d, src+(size_t)y*W, W);
+    else std::memcpy(d, src+(size_t)y*W, W*sizeof(uint32_t));
+  }
+  if(stream) stream_fence();
+}
+
+void stream_row(uint32_t* dst, const uint32_t* src, int n){
+  int i=0;
+#if defined(__SSE2__)
+  // Cabeza escalar hasta alinear dst a 16 B; luego 4 píxeles por store
+  for(; i<n && ((uintptr_t)(dst+i)&15); ++i) dst[i]=src[i];
+  for(; i+4<=n; i+=4)
+    _mm_stream_si128((__m128i*)(dst+i), _mm_loadu_si128((const __m128i*)(src+i)));
+#endif
+  for(; i<n; ++i) dst[i]=src[i];
+}
+
+void stream_fence(){
+#if defined(__SSE2__)
+  _mm_sfence();
+#endif
+}
+} // namespace detail
+
+// =====================================================
+// render_frame: dibuja desc.rect en `out` con el executor dado
+// - Full-res: tiles TW x TH de la región (índice plano = collapse(2)),
+//   mejor localidad de cache y sin false sharing entre hilos.
+// - Low-res (scale < 1): tiles TW x TH en la malla reducida SW x SH; cada
+//   píxel reducido se muestrea exactamente una vez y su fila se expande
+//   (upscale_row) y se replica en las filas de salida que la usan. Misma
+//   fórmula de muestreo que el frame completo, así que cualquier partición
+//   en subrectángulos da la misma imagen.
+// - stream: cada fila terminada (de tile o ya escalada) se arma en un
+//   buffer local alineado y se escribe con stores non-temporal, así el
+//   framebuffer no desaloja de la cache el working set del ruido.
+// - HUD (desc.hud): los tramos de fila que lo cruzan también pasan por el
+//   buffer local, se mezclan ahí y recién entonces se escriben; `out` sólo
+//   recibe stores.
+// =====================================================
+void render_frame(const FrameDesc& d, float t, uint32_t* out, size_t stride, Executor& ex){
+  if(!d.field || !out || d.width<=0 || d.height<=0) return;
+  const NebulaField& field=*d.field;
+  const int W=d.width, H=d.height;
+  const int rx=d.rect.x, ry=d.rect.y;
+  const int x0=std::max(0,rx), y0=std::max(0,ry);
+  const int x1=d.rect.w>0 ? std::min(W,rx+d.rect.w) : W;
+  const int y1=d.rect.h>0 ? std::min(H,ry+d.rect.h) : H;
+  if(x0>=x1 || y0>=y1) return;
+
+  const int TW=std::max(1,d.params.tile_w), TH=std::max(1,d.params.tile_h);
+  const float s=std::clamp(d.params.scale,0.01f,1.0f);
+  const bool nt=d.params.stream;
+  // Fila y del frame dentro de `out`, indexable con x del frame
+  auto row_at=[&](int y){ return (uint32_t*)((uint8_t*)out+(size_t)(y-ry)*stride)-rx; };
+  // ¿El tramo [a,b) de la fila y cruza el HUD?
+  const hud::Overlay* hud=d.hud;
+  const int hx=d.hud_x, hy=d.hud_y;
+  auto hits_hud=[&](int y, int a, int b){
+    return hud && y>=hy && y<hy+hud->height() && a<hx+hud->width() && b>hx;
+  };
+  // Contadores de tráfico: una suma atómica por tile/banda
+  auto count=[&](int px){
+    if(!d.stats) return;
+    (nt ? d.stats->bytes_streamed : d.stats->bytes_written)
+      .fetch_add((uint64_t)px*sizeof(uint32_t), std::memory_order_relaxed);
+  };
+
+  if(s >= 0.999f){
+    // ================= FULL-RES (tiling) =================
+    const int ntx=(x1-x0+TW-1)/TW, nty=(y1-y0+TH-1)/TH;
+    ex.parallel_for(ntx*nty, [&](int i){
+      const int ty=i/ntx, tx=i%ntx;
+      const int ty0=y0+ty*TH, ty1=std::min(y1,ty0+TH);
+      const int tx0=x0+tx*TW, tx1=std::min(x1,tx0+TW);
+      thread_local PixelBuffer buf;
+      buf.resize(tx1-tx0);
+      for(int y=ty0; y<ty1; ++y){
+        uint32_t* row=row_at(y);
+        const bool h=hits_hud(y,tx0,tx1);
+        if(!nt && !h){
+          for(int x=tx0; x<tx1; ++x) row[x]=field.sample_pixel(x,y,t);
+          continue;
+        }
+        for(int x=tx0; x<tx1; ++x) buf[x-tx0]=field.sample_pixel(x,y,t);
+        if(h) hud->blend_span(buf.data(), tx0, tx1, y, hx, hy);
+        if(nt) detail::stream_row(row+tx0, buf.data(), tx1-tx0);
+        else   std::memcpy(row+tx0, buf.data(), (size_t)(tx1-tx0)*sizeof(uint32_t));
+      }
+      if(nt) detail::stream_fence();
+      count((tx1-tx0)*(ty1-ty0));
+    });
+  } else {
+    // ============== LOW-RES + UPSCALE ===================
+    const int SW=std::max(1,(int)std::floor(W*s));
+    const int SH=std::max(1,(int)std::floor(H*s));
+    auto sx_of=[&](int x){ return std::min(SW-1,(int)(x*s)); };
+    auto sy_of=[&](int y){ return std::min(SH-1,(int)(y*s)); };
+    const int sx0=sx_of(x0), sx1=sx_of(x1-1)+1;
+    const int sy0=sy_of(y0), sy1=sy_of(y1-1)+1;
+    // xs[k]/ys[k]: primera columna/fila de salida que usa sx0+k / sy0+k
+    // (s < 1: toda columna/fila reducida del rango tiene al menos una)
+    std::vector<int> xs(sx1-sx0+1), ys(sy1-sy0+1);
+    for(int x=x1-1; x>=x0; --x) xs[sx_of(x)-sx0]=x;
+    for(int y=y1-1; y>=y0; --y) ys[sy_of(y)-sy0]=y;
+    xs[sx1-sx0]=x1; ys[sy1-sy0]=y1;
+
+    const int ntx=(sx1-sx0+TW-1)/TW, nty=(sy1-sy0+TH-1)/TH;
+    ex.parallel_for(ntx*nty, [&](int i){
+      const int ty=i/ntx, tx=i%ntx;
+      const int tsy0=sy0+ty*TH, tsy1=std::min(sy1,tsy0+TH);
+      const int tsx0=sx0+tx*TW, tsx1=std::min(sx1,tsx0+TW);
+      const int ox0=xs[tsx0-sx0], ox1=xs[tsx1-sx0];
+      // low: fila reducida del tile; wide: la misma ya escalada;
+      // hrow: copia de wide con el HUD mezclado (filas que lo cruzan)
+      thread_local std::vector<uint32_t> low;
+      thread_local PixelBuffer wide, hrow;
+      low.resize(tsx1-tsx0);
+      wide.resize(ox1-ox0);
+      for(int sy=tsy0; sy<tsy1; ++sy){
+        // Muestreo centrado para evitar aliasing duro
+        const int YY=std::min(H-1,(int)((sy+0.5f)/s));
+        for(int sx=tsx0; sx<tsx1; ++sx){
+          const int XX=std::min(W-1,(int)((sx+0.5f)/s));
+          low[sx-tsx0]=field.sample_pixel(XX,YY,t);
+        }
+        detail::upscale_row(wide.data(), low.data(), ox0, ox1, tsx0, s, SW);
+        for(int y=ys[sy-sy0]; y<ys[sy-sy0+1]; ++y){
+          uint32_t* row=row_at(y)+ox0;
+          const uint32_t* src=wide.data();
+          if(hits_hud(y,ox0,ox1)){
+            hrow.assign(wide.begin(), wide.end());
+            hud->blend_span(hrow.data(), ox0, ox1, y, hx, hy);
+            src=hrow.data();
+          }
+          if(nt) detail::stream_row(row, src, ox1-ox0);
+          else   std::memcpy(row, src, (size_t)(ox1-ox0)*sizeof(uint32_t));
+        }
+      }
+      if(nt) detail::stream_fence();
+      count((ox1-ox0)*(ys[tsy1-sy0]-ys[tsy0-sy0]));
+    });
+  }
+}
+
+void render_frame(const FrameDesc& desc, float t, uint32_t* out, size_t stride){
+  SerialExecutor ex;
+  render_frame(desc, t, out, stride, ex);
+}
+
+// render_field: frame completo en el framebuffer RAM (pixels), con el
+// equipo OpenMP (schedule(runtime)) o en serie
+void render_field(const NebulaField& field, int W, int H, const RenderParams& rp, float t,
+                  PixelBuffer& pixels, RenderStats* stats){
+  pixels.resize((size_t)W*H);
+  FrameDesc d;
+  d.field=&field; d.width=W; d.height=H; d.params=rp; d.stats=stats;
+  if(rp.use_omp){
+    OmpExecutor ex;
+    render_frame(d, t, pixels.data(), (size_t)W*sizeof(uint32_t), ex);
+  } else {
+    render_frame(d, t, pixels.data(), (size_t)W*sizeof(uint32_t));
+  }
+}
@@ -1,109 +1,28 @@
 #include "core/screensaver.hpp"
 #include "core/field.hpp"
 #include "core/fps_counter.hpp"
+#include "core/hud.hpp"
+#include "core/internal.hpp"
+#include "core/pacing.hpp"
+#include "core/renderer.hpp"
 
 #include <SDL.h>
 #include <cstdio>
 #include <vector>
 #include <chrono>
-#include <cstring>    // memcpy
 #include <algorithm>  // min/max
 #include <cmath>
+#include <string>
 
 #if defined(_OPENMP)
   #include <omp.h>   // OpenMP (paralelismo en memoria compartida)
 #endif
 
-// =====================================================
-//  Mini HUD: dibujar texto 5x7 y rectángulo semitransparente
-//  (sin SDL_ttf; fuente bitmap mínima para mostrar FPS, etc.)
-// =====================================================
-namespace hud {
-
-struct Glyph { uint8_t rows[7]; };
-static const Glyph* get(char c);
-
-// 5x7 (bitmask por fila). Cada byte codifica 5 bits útiles.
-static const Glyph G0{{0x1E,0x11,0x13,0x15,0x19,0x11,0x1E}};
-static const Glyph G1{{0x04,0x0C,0x14,0x04,0x04,0x04,0x1F}};
-static const Glyph G2{{0x1E,0x01,0x01,0x1E,0x10,0x10,0x1F}};
-static const Glyph G3{{0x1E,0x01,0x01,0x0E,0x01,0x01,0x1E}};
-static const Glyph G4{{0x02,0x06,0x0A,0x12,0x1F,0x02,0x02}};
-static const Glyph G5{{0x1F,0x10,0x10,0x1E,0x01,0x01,0x1E}};
-static const Glyph G6{{0x0E,0x10,0x10,0x1E,0x11,0x11,0x0E}};
-static const Glyph G7{{0x1F,0x01,0x02,0x04,0x08,0x08,0x08}};
-static const Glyph G8{{0x0E,0x11,0x11,0x0E,0x11,0x11,0x0E}};
-static const Glyph G9{{0x0E,0x11,0x11,0x0F,0x01,0x01,0x0E}};
-static const Glyph SP{{0x00,0x00,0x00,0x00,0x00,0x00,0x00}};
-static const Glyph DOT{{0x00,0x00,0x00,0x00,0x00,0x06,0x06}};
-static const Glyph GF{{0x1F,0x10,0x10,0x1E,0x10,0x10,0x10}}; // F
-static const Glyph GP{{0x1E,0x11,0x11,0x1E,0x10,0x10,0x10}}; // P
-static const Glyph GS{{0x0F,0x10,0x10,0x0E,0x01,0x01,0x1E}}; // S
-static const Glyph GX{{0x11,0x0A,0x04,0x04,0x0A,0x11,0x11}}; // x
-
-// Devuelve el glyph para el caracter solicitado.
-inline const Glyph* get(char c){
-  switch(c){
-    case '0':return &G0; case '1':return &G1; case '2':return &G2; case '3':return &G3; case '4':return &G4;
-    case '5':return &G5; case '6':return &G6; case '7':return &G7; case '8':return &G8; case '9':return &G9;
-    case ' ':return &SP; case '.':return &DOT; case 'F':return &GF; case 'P':return &GP; case 'S':return &GS;
-    case 'x':return &GX; default:return &SP;
-  }
-}
-
-// Escritura segura de un pixel RGBA en el framebuffer (clamp bounds)
-static inline void put(std::vector<uint32_t>& pix,int W,int H,int x,int y,uint32_t rgba){
-  if((unsigned)x<(unsigned)W && (unsigned)y<(unsigned)H) pix[y*W+x]=rgba;
-}
-
-// Dibuja un carácter 5x7 a escala `s` con sombra
-static void draw_char(std::vector<uint32_t>& pix,int W,int H,int x,int y,char c,uint32_t rgba,int s=3){
-  const Glyph* g=get(c);
-  for(int ry=0; ry<7; ++ry){
-    uint8_t row=g->rows[ry];
-    for(int rx=0; rx<5; ++rx){
-      if(((row>>(4-rx))&1)==0) continue;
-      for(int dy=0; dy<s; ++dy)
-        for(int dx=0; dx<s; ++dx)
-          put(pix,W,H,x+rx*s+dx,y+ry*s+dy,rgba);
-    }
-  }
-}
-
-// Dibuja una cadena con sombra sutil (1px) para mejorar legibilidad
-static void draw_text(std::vector<uint32_t>& pix,int W,int H,int x,int y,const char* s,uint32_t rgba,int scale=3){
-  int cx=x;
-  for(const char* p=s; *p; ++p){
-    draw_char(pix,W,H,cx+1,y+1,*p,0x80000000u,scale); // sombra
-    draw_char(pix,W,H,cx,  y,  *p,rgba,scale);
-    cx+= (5*scale + 1*scale); // ancho de glyph + espacio
-  }
-}
 
-// Composición alpha sobre (fg over bg)
-static inline uint32_t blend_over(uint32_t bg, uint32_t fg){
-  uint8_t a=(fg>>24)&0xFF; if(a==0) return bg; if(a==255) return fg;
-  float af=a/255.f;
-  uint8_t br=(bg>>16)&0xFF, bgc=(bg>>8)&0xFF, bb=bg&0xFF;
-  uint8_t fr=(fg>>16)&0xFF, fgc=(fg>>8)&0xFF, fb=fg&0xFF;
-  uint8_t r=(uint8_t)(fr*af + br*(1-af));
-  uint8_t g=(uint8_t)(fgc*af + bgc*(1-af));
-  uint8_t b=(uint8_t)(fb*af + bb*(1-af));
-  return 0xFF000000u | (r<<16) | (g<<8) | b;
-}
-
-// Rellena un rectángulo con alpha mezclando sobre el framebuffer
-static void fill_rect_blend(std::vector<uint32_t>& pix,int W,int H,int x,int y,int w,int h,uint32_t rgba){
-  int x1=std::max(0,x), y1=std::max(0,y);
-  int x2=std::min(W,x+w), y2=std::min(H,y+h);
-  for(int yy=y1; yy<y2; ++yy){
-    uint32_t* row=pix.data()+yy*W;
-    for(int xx=x1; xx<x2; ++xx) row[xx]=blend_over(row[xx],rgba);
-  }
-}
-} // namespace hud
-// ------------------------------------------------------------------------
 
+// Instante de arranque del proceso (inicialización estática, antes de
+// main): referencia del log de time-to-first-present
+static const std::chrono::steady_clock::time_point g_launch = std::chrono::steady_clock::now();
 
 // =====================================================
 //    Screensaver: ciclo de vida SDL
@@ -156,46 +75,83 @@ void Screensaver::shutdown(){
 // =====================================================
 // render_loop: ejecuta el bucle de render (seq/omp)
 // - Construye NebulaField
-// - Dibuja la imagen en un framebuffer RAM (pixels)
+// - Dibuja la imagen con render_frame en un framebuffer RAM (pixels) y la
+//   copia a la textura, o (stream) directo en la textura bloqueada con
+//   stores non-temporal: una sola pasada de escritura por frame
 // - Sube la textura a GPU y presenta
-// - Modo full-res o low-res+upscale según render_scale
-// En modo OpenMP se muestra sincronización explícita:
-//   * omp for (tiles) + collapse(2)
-//   * barrier + single (evita data races con SDL)
+// - Arranque progresivo: los primeros frames salen a 1/8, 1/4 y 1/2 de
+//   escala (mismo camino low-res + upscale) hasta el primero completo
 // =====================================================
 static int render_loop(SDL_Renderer* renderer, SDL_Texture* texture, const AppConfig& cfg, bool use_omp){
   NebulaField field(cfg);
   FPSCounter fps;
   using clk=std::chrono::steady_clock;
   auto t0=clk::now();
+  auto since_launch=[](){ return std::chrono::duration<double,std::milli>(clk::now()-g_launch).count(); };
+  const double ready_ms=since_launch();   // ventana + campo listos
 
   const int W=cfg.width, H=cfg.height;
-  std::vector<uint32_t> pixels((size_t)W*H);
   SDL_Event ev{}; bool running=true;
 
+  // Escala de render + forma del tile (--chunk o --tile / autotune)
+  const RenderParams rp = render_params_from(cfg, use_omp);
+  const float s = rp.scale;
+
+  // Executor del frame: equipo OpenMP (schedule(runtime)) o serie
+  OmpExecutor omp_ex; SerialExecutor seq_ex;
+  Executor& exec = use_omp ? static_cast<Executor&>(omp_ex) : seq_ex;
+  FrameDesc desc;
+  desc.field=&field; desc.width=W; desc.height=H; desc.params=rp;
+
+  // Escalera del arranque progresivo: sólo escalas menores que la final
+  std::vector<float> ladder;
+  if(cfg.progressive)
+    for(float ps : {0.125f, 0.25f, 0.5f}) if(ps < s-1e-3f) ladder.push_back(ps);
+  size_t stage=0;
+
+  // Framebuffer RAM (alineado a 64 B); en modo stream no hace falta
+  PixelBuffer pixels(rp.stream ? 0 : (size_t)W*H);
+
+  // Tráfico de escritura por frame: render (RenderStats, HUD incluido) + copia
+  RenderStats mem;
+  desc.stats=&mem;
+  uint64_t acc_bytes=0, pw_bytes=0, pw_streamed=0;
+  double mb_frame=0;
+
+  // HUD cacheado + tiempos por fase (render / HUD / upload+present), en ms
+  hud::Overlay overlay;
+  double acc_render=0, acc_hud=0, acc_upload=0; int acc_frames=0;
+  double ms_render=0, ms_hud=0, ms_upload=0;
+
+  // Energía: pacing, escena fija y CPU-segundos por frame mostrado
+  FramePacer pacer(cfg.fps_cap);
+  const bool still = field.is_static();
+  bool presented = false;        // ya se mostró un frame a calidad final
+  long   pw_frames = 0, tot_frames = 0;
+  long   full_frames = 0;       // frames a calidad final (los peldaños no cuentan)
+  double pw_cpu0 = process_cpu_seconds(), cpu_start = pw_cpu0;
+  auto   pw_t0 = clk::now();
+  if(still){
+    std::printf("[POWER] static scene (zspeed=0 drift=0 stars=0): rendering once\n");
+    std::fflush(stdout);
+  }
+
 #if defined(_OPENMP)
   // Configurar política de scheduling si se solicitó (runtime control)
   if(use_omp){
-    omp_sched_t kind=omp_sched_static;
-    if      (cfg.omp_schedule=="dynamic") kind=omp_sched_dynamic;
-    else if (cfg.omp_schedule=="guided")  kind=omp_sched_guided;
-    else if (cfg.omp_schedule=="auto")    kind=omp_sched_auto;
-    omp_set_schedule(kind,cfg.omp_chunk);
+    apply_omp_runtime(cfg.omp_schedule, cfg.omp_chunk, cfg.threads);
 
     // Log de confirmación de scheduling/hilos
     omp_sched_t k2; int ch2; omp_get_schedule(&k2,&ch2);
     const char* kname=(k2==omp_sched_static)?"static":(k2==omp_sched_dynamic)?"dynamic":(k2==omp_sched_guided)?"guided":"auto";
-    std::printf("[OMP] max_threads=%d schedule=%s chunk=%d\n", omp_get_max_threads(), kname, ch2);
+    std::printf("[OMP] max_threads=%d schedule=%s chunk=%d tile=%dx%d\n",
+                omp_get_max_threads(), kname, ch2, rp.tile_w, rp.tile_h);
     std::fflush(stdout);
   }
 #endif
-
-  // Escala de render (low-res interno para subir FPS)
-  const float s = std::clamp(cfg.render_scale, 0.3f, 1.0f);
-
-  // Tamaño de tile (usamos chunk como guía; clamp para cache-friendliness)
-  int TS = (cfg.omp_chunk>0 ? cfg.omp_chunk : 32);
-  TS = std::max(8, std::min(64, TS));
+  std::printf("[MEM] stream=%s frame=%.1f MB llc=%.1f MB\n", rp.stream?"on":"off",
+              W*H*4/1048576.0, llc_bytes()/1048576.0);
+  std::fflush(stdout);
 
   while(running){
     // Entrada: salir con ESC o cerrar ventana
@@ -203,147 +159,133 @@ static int render_loop(SDL_Renderer* renderer, SDL_Texture* texture, const AppCo
       if(ev.type==SDL_QUIT) running=false;
       if(ev.type==SDL_KEYDOWN && ev.key.keysym.sym==SDLK_ESCAPE) running=false;
     }
-    float t = std::chrono::duration<float>(clk::now()-t0).count();
-
-    if(s >= 0.999f){
-      // ================= FULL-RES (tiling) =================
-      // Procesa por tiles para mejorar localidad de cache y disminuir false sharing.
-      const int ntx=(W+TS-1)/TS, nty=(H+TS-1)/TS;
 
-#if defined(_OPENMP)
-      if(use_omp){
-        #pragma omp parallel
-        {
-          // Cada hilo toma tiles según la política omp_set_schedule(...)
-          #pragma omp for collapse(2) schedule(runtime)
-          for(int ty=0; ty<nty; ++ty){
-            for(int tx=0; tx<ntx; ++tx){
-              int y0=ty*TS, y1=std::min(H,y0+TS);
-              int x0=tx*TS, x1=std::min(W,x0+TS);
-              for(int y=y0; y<y1; ++y){
-                uint32_t* row=pixels.data()+y*W;
-                #pragma omp simd
-                for(int x=x0; x<x1; ++x){
-                  row[x]=field.sample_pixel(x,y,t);
-                }
-              }
-            }
-          }
-
-          // ---- Sincronización explícita ----
-          #pragma omp barrier     // espera a que todos terminen sus tiles
-          #pragma omp single      // solo un hilo sube/Present (SDL no es thread-safe)
-          { /* hook opcional de sync; Upload/Present se realiza más abajo */ }
-        }
-      } else
-#endif
-      {
-        // Secuencial: barrido por filas
-        for(int y=0; y<H; ++y){
-          uint32_t* row=pixels.data()+y*W;
-          for(int x=0; x<W; ++x) row[x]=field.sample_pixel(x,y,t);
-        }
-      }
-
-    } else {
-      // ============== LOW-RES + UPSCALE ===================
-      // 1) Renderiza en un buffer reducido (SW x SH).
-      // 2) Escala al framebuffer final (W x H).
-      const int SW=std::max(1,(int)std::floor(W*s));
-      const int SH=std::max(1,(int)std::floor(H*s));
-      static std::vector<uint32_t> lowres; lowres.assign((size_t)SW*SH,0);
-
-#if defined(_OPENMP)
-      if(use_omp){
-        #pragma omp parallel
-        {
-          // a) Calcular lowres por tiles
-          const int ntx=(SW+TS-1)/TS, nty=(SH+TS-1)/TS;
-          #pragma omp for collapse(2) schedule(runtime)
-          for(int ty=0; ty<nty; ++ty){
-            for(int tx=0; tx<ntx; ++tx){
-              int y0=ty*TS, y1=std::min(SH,y0+TS);
-              int x0=tx*TS, x1=std::min(SW,x0+TS);
-              for(int sy=y0; sy<y1; ++sy){
-                for(int sx=x0; sx<x1; ++sx){
-                  // Muestreo centrado para evitar aliasing duro
-                  int XX=std::min(W-1,(int)((sx+0.5f)/s));
-                  int YY=std::min(H-1,(int)((sy+0.5f)/s));
-                  lowres[sy*SW+sx]=field.sample_pixel(XX,YY,t);
-                }
-              }
-            }
-          }
-
-          // b) Upscale filas completas (paralelo)
-          #pragma omp for schedule(static)
-          for(int y=0; y<H; ++y){
-            int sy=std::min(SH-1,(int)(y*s));
-            uint32_t* row=pixels.data()+y*W;
-            const uint32_t* srow=lowres.data()+sy*SW;
-            #pragma omp simd
-            for(int x=0; x<W; ++x){
-              int sx=std::min(SW-1,(int)(x*s));
-              row[x]=srow[sx];
-            }
-          }
-        }
-      } else
-#endif
-      {
-        // Secuencial: calcular lowres y luego escalar
-        for(int sy=0; sy<SH; ++sy){
-          int YY=std::min(H-1,(int)((sy+0.5f)/s));
-          for(int sx=0; sx<SW; ++sx){
-            int XX=std::min(W-1,(int)((sx+0.5f)/s));
-            lowres[sy*SW+sx]=field.sample_pixel(XX,YY,t);
-          }
-        }
-        for(int y=0; y<H; ++y){
-          int sy=std::min(SH-1,(int)(y*s));
-          uint32_t* row=pixels.data()+y*W;
-          const uint32_t* srow=lowres.data()+sy*SW;
-          for(int x=0; x<W; ++x){
-            int sx=std::min(SW-1,(int)(x*s));
-            row[x]=srow[sx];
-          }
+    // Escena fija ya presentada: nada puede cambiar, así que el hilo
+    // principal se bloquea en la cola de eventos (el equipo OpenMP queda
+    // ocioso). Sólo se re-presenta la textura si la ventana lo pide.
+    if(still && presented){
+      if(SDL_WaitEventTimeout(&ev,500)){
+        if(ev.type==SDL_QUIT) running=false;
+        if(ev.type==SDL_KEYDOWN && ev.key.keysym.sym==SDLK_ESCAPE) running=false;
+        if(ev.type==SDL_WINDOWEVENT){
+          SDL_RenderClear(renderer);
+          SDL_RenderCopy(renderer,texture,nullptr,nullptr);
+          SDL_RenderPresent(renderer);
         }
       }
+      continue;
     }
+    // Tiempo real, o secuencia fija de 60 pasos/s en modo determinista
+    // (indexada por frames a calidad final: el arranque progresivo no la corre)
+    float t = cfg.deterministic ? float(full_frames) / 60.f
+                                : std::chrono::duration<float>(clk::now()-t0).count();
 
-    // ----- HUD: mostrar FPS, hilos, n y scale (sobre el framebuffer) -----
-    fps.tick();
+    // Destino del render: la textura bloqueada (stream) o el framebuffer RAM
+    void* tex_pixels=nullptr; int pitch=0;
+    uint32_t* out=pixels.data(); size_t stride=(size_t)W*sizeof(uint32_t);
+    if(rp.stream){
+      SDL_LockTexture(texture,nullptr,&tex_pixels,&pitch);
+      out=(uint32_t*)tex_pixels; stride=(size_t)pitch;
+    }
+    uint64_t other_bytes=0;
+
+    // Escala de este frame (peldaño progresivo o la final)
+    const bool full = stage >= ladder.size();
+    desc.params.scale = full ? s : ladder[stage];
+
+    // ----- HUD: FPS, hilos, n, scale y tiempos por fase (overlay cacheado) -----
+    // Los tiempos se promedian en la misma ventana que el FPS, así el texto
+    // (y la capa rasterizada) sólo cambia cada 500 ms. La mezcla la hace
+    // render_frame en su buffer de fila (nunca se relee la textura).
+    auto th0=clk::now();
+    bool fps_updated = fps.tick();
     if (cfg.show_fps){
-      char hudtxt[96];
+      if (fps_updated && acc_frames>0){
+        ms_render=acc_render/acc_frames; ms_hud=acc_hud/acc_frames; ms_upload=acc_upload/acc_frames;
+        mb_frame=acc_bytes/1e6/acc_frames;
+        acc_render=acc_hud=acc_upload=0.0; acc_frames=0; acc_bytes=0;
+      }
+      char hudtxt[160];
 #if defined(_OPENMP)
       int th = use_omp ? omp_get_max_threads() : 1;
 #else
       int th = 1;
 #endif
-      std::snprintf(hudtxt,sizeof(hudtxt),"FPS %.1f  x%d  n=%d  s=%.2f",
-                    fps.fps(), th, cfg.n, s);
+      std::snprintf(hudtxt,sizeof(hudtxt),"FPS %.1f  x%d  n=%d  s=%.2f\nR %.1f  H %.2f  U %.1f MS  %.1f MB/F",
+                    fps.fps(), th, cfg.n, desc.params.scale, ms_render, ms_hud, ms_upload, mb_frame);
 
       // Tamaño del texto según resolución
       int scale_px = (W>=1600?4:(W>=1100?3:3));
-      int text_w = (int)std::strlen(hudtxt) * (5*scale_px + 1*scale_px);
-      int text_h = 7*scale_px;
-
-      // Caja semitransparente + texto con sombra
-      hud::fill_rect_blend(pixels,W,H,8,8,text_w+14,text_h+14,0x66000000u);
-      hud::draw_text(pixels,W,H,15,15,hudtxt,0xFFFFFFFFu,scale_px);
+      overlay.update(hudtxt, scale_px);
     }
+    desc.hud = cfg.show_fps ? &overlay : nullptr;
+
+    auto tr0=clk::now();
+    render_frame(desc, t, out, stride, exec);
+    auto tr1=clk::now();
 
     // ----- Upload a textura + presentar en la ventana -----
-    void* tex_pixels=nullptr; int pitch=0;
-    SDL_LockTexture(texture,nullptr,&tex_pixels,&pitch);
-    for(int y=0;y<H;++y){
-      std::memcpy((uint8_t*)tex_pixels + y*pitch, pixels.data()+y*W, W*sizeof(uint32_t));
+    if(!rp.stream){
+      SDL_LockTexture(texture,nullptr,&tex_pixels,&pitch);
+      detail::copy_rows(tex_pixels,pitch,pixels.data(),W,H);
+      other_bytes += (uint64_t)W*H*4;
     }
     SDL_UnlockTexture(texture);
 
     SDL_RenderClear(renderer);
     SDL_RenderCopy(renderer,texture,nullptr,nullptr);
     SDL_RenderPresent(renderer);
+
+    auto tr3=clk::now();
+    acc_render += std::chrono::duration<double,std::milli>(tr1-tr0).count();
+    acc_hud    += std::chrono::duration<double,std::milli>(tr0-th0).count();
+    acc_upload += std::chrono::duration<double,std::milli>(tr3-tr1).count();
+    ++acc_frames;
+
+    // Latencia de arranque: primer present y primer frame a calidad final
+    if(tot_frames==0){
+      std::printf("[STARTUP] first present at %.1f ms after launch (ready %.1f ms, scale %.3f, render %.1f ms)\n",
+                  since_launch(), ready_ms, desc.params.scale,
+                  std::chrono::duration<double,std::milli>(tr1-tr0).count());
+      std::fflush(stdout);
+    }
+    if(full){
+      if(!presented && !ladder.empty()){
+        std::printf("[STARTUP] full quality (scale %.2f) at %.1f ms after launch\n", s, since_launch());
+        std::fflush(stdout);
+      }
+      presented = true;
+      ++full_frames;
+    } else {
+      ++stage;
+    }
+
+    const uint64_t frame_bytes = mem.total() + other_bytes;
+    acc_bytes += frame_bytes; pw_bytes += frame_bytes; pw_streamed += mem.bytes_streamed;
+    mem.reset();
+
+    // CPU-segundos por frame mostrado (ventana de 5 s)
+    ++pw_frames; ++tot_frames;
+    double wall = std::chrono::duration<double>(clk::now()-pw_t0).count();
+    if(wall >= 5.0){
+      double cpu = process_cpu_seconds() - pw_cpu0;
+      std::printf("[POWER] fps=%.1f cpu_s/frame=%.4f cpu_util=%.0f%%\n",
+                  pw_frames/wall, cpu/pw_frames, 100.0*cpu/wall);
+      std::printf("[MEM] written/frame=%.1f MB (streamed %.0f%%) write_bw=%.2f GB/s\n",
+                  pw_bytes/1e6/pw_frames, pw_bytes ? 100.0*pw_streamed/pw_bytes : 0.0,
+                  pw_bytes/1e9/wall);
+      std::fflush(stdout);
+      pw_frames = 0; pw_cpu0 += cpu; pw_t0 = clk::now();
+      pw_bytes = pw_streamed = 0;
+    }
+
+    if(full) pacer.wait();   // los peldaños progresivos no esperan
+  }
+
+  if(tot_frames>0){
+    double cpu = process_cpu_seconds() - cpu_start;
+    std::printf("[POWER] total frames=%ld cpu=%.2fs cpu_s/frame=%.4f\n",
+                tot_frames, cpu, cpu/tot_frames);
   }
   return 0;
 }
@@ -1,9 +1,43 @@
+#include "core/autotune.hpp"
 #include "core/cli.hpp"
+#include "core/pacing.hpp"
 #include "core/screensaver.hpp"
+#include <cstring>
 #include <iostream>
 
+static bool has_arg(int argc, char** argv, const char* key) {
+  for (int i = 1; i < argc; ++i)
+    if (!std::strcmp(argv[i], key)) return true;
+  return false;
+}
+
 int main(int argc, char** argv) {
   AppConfig cfg = parse_cli(argc, argv);
+
+  // Debe ir antes de cualquier región paralela (re-ejecuta si hace falta)
+  apply_omp_wait_policy(cfg.wait_policy, argv);
+
+  // Autotuner: barrido nuevo con --autotune, o el resultado en cache para
+  // esta CPU/resolución. Las opciones explícitas en argv siguen ganando.
+  TuneResult tuned;
+  bool have_tuned = cfg.autotune ? true : autotune_load(cfg, tuned);
+  if (cfg.autotune) {
+    tuned = autotune_run(cfg);
+    autotune_save(cfg, tuned);
+  }
+  if (have_tuned) {
+    AppConfig defaults;
+    autotune_apply(defaults, tuned);
+    cfg = parse_cli(argc, argv, defaults);
+    // --chunk explícito sin --tile: el tile vuelve a derivarse del chunk
+    // (un tile_w/tile_h != 0 de la cache le ganaría en render_params_from)
+    if (has_arg(argc, argv, "--chunk") && !has_arg(argc, argv, "--tile"))
+      cfg.tile_w = cfg.tile_h = 0;
+    std::cout << "[TUNE] using tile=" << cfg.tile_w << "x" << cfg.tile_h
+              << " sched=" << cfg.omp_schedule << " chunk=" << cfg.omp_chunk
+              << " threads=" << cfg.threads << " scale=" << cfg.render_scale << std::endl;
+  }
+
   std::cout << "[OMP] " << cfg.window_title << "\n"
             << "  size=" << cfg.width << "x" << cfg.height
             << "  N(octaves)=" << cfg.n
@@ -11,4 +45,4 @@ int main(int argc, char** argv) {
             << "  zspeed=" << cfg.zspeed << std::endl;
   Screensaver app(cfg);
   return app.run_omp();
-}
\ No newline at end of file
+}
@@ -0,0 +1,25 @@
+# =====================================================
+#  Test: render_offline da los mismos bytes con 1 worker (frame completo)
+#  que con 3 workers repartiendo bandas de tamaño impar.
+#  Uso: cmake -DEXE=<render_offline> -DOUT=<dir> [-DSCALE=<f>] -P dist_identical.cmake
+# =====================================================
+if(NOT SCALE)
+  set(SCALE 1.0)
+endif()
+set(scene -w 160 -h 120 --seed 7 --render-scale ${SCALE} --frames 6)
+file(MAKE_DIRECTORY ${OUT})
+
+execute_process(COMMAND ${EXE} ${scene} --workers 1 --split frame --out ${OUT}/w1.raw
+                RESULT_VARIABLE rc1)
+execute_process(COMMAND ${EXE} ${scene} --workers 3 --split band --band-rows 37 --out ${OUT}/w3.raw
+                RESULT_VARIABLE rc3)
+if(NOT rc1 EQUAL 0 OR NOT rc3 EQUAL 0)
+  message(FATAL_ERROR "render_offline failed (1 worker: ${rc1}, 3 workers: ${rc3})")
+endif()
+
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${OUT}/w1.raw ${OUT}/w3.raw
+                RESULT_VARIABLE diff)
+if(NOT diff EQUAL 0)
+  message(FATAL_ERROR "scale ${SCALE}: 1 worker and 3 workers (band split) differ")
+endif()
+message(STATUS "scale ${SCALE}: 1 vs 3 workers identical")
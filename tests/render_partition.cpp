@@ -0,0 +1,83 @@
+#include "core/renderer.hpp"
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// =====================================================
+//  Test: cualquier partición en subrectángulos de render_frame da
+//  exactamente el frame completo, con ThreadPoolExecutor y TaskExecutor,
+//  a escala 1 y < 1, con y sin stores non-temporal.
+//  Referencia: render_field en serie. Sale con 1 si algún píxel difiere.
+// =====================================================
+
+// Pool "del host" mínimo para TaskExecutor: un std::thread por tarea
+struct HostThreads {
+  std::mutex m;
+  std::vector<std::thread> th;
+  void submit(std::function<void()> fn) {
+    std::lock_guard<std::mutex> lk(m);
+    th.emplace_back(std::move(fn));
+  }
+  void join() { for (auto& t : th) t.join(); th.clear(); }
+};
+
+// Renderiza el frame como una malla de rectángulos RW x RH sobre un buffer
+// con pitch > ancho (como una textura), cada rect con el executor dado
+static PixelBuffer render_tiled(const FrameDesc& d, float t, int RW, int RH, Executor& ex) {
+  const int W = d.width, H = d.height, pitch = W + 13;
+  PixelBuffer buf((size_t)pitch * H, 0u);
+  for (int y = 0; y < H; y += RH)
+    for (int x = 0; x < W; x += RW) {
+      FrameDesc r = d;
+      r.rect = {x, y, RW, RH};   // el último de cada fila/columna se recorta
+      render_frame(r, t, buf.data() + (size_t)y * pitch + x, (size_t)pitch * sizeof(uint32_t), ex);
+    }
+  PixelBuffer out((size_t)W * H);
+  for (int y = 0; y < H; ++y)
+    for (int x = 0; x < W; ++x) out[(size_t)y * W + x] = buf[(size_t)y * pitch + x];
+  return out;
+}
+
+static long diff(const PixelBuffer& a, const PixelBuffer& b) {
+  long n = 0;
+  for (size_t i = 0; i < a.size(); ++i) n += a[i] != b[i];
+  return n;
+}
+
+int main() {
+  AppConfig c;
+  c.width = 211; c.height = 131; c.seed = 7; c.deterministic = true;
+  c.clamp_to_valid_ranges();
+  NebulaField field(c);
+  const int W = c.width, H = c.height;
+  const float t = 1.5f;
+
+  ThreadPoolExecutor pool(4);
+  HostThreads host;
+  TaskExecutor task([&](std::function<void()> fn) { host.submit(std::move(fn)); }, 3);
+
+  long fails = 0;
+  for (float s : {1.0f, 0.5f, 0.37f, 0.3f})
+    for (int tw : {7, 32})
+      for (bool nt : {false, true}) {
+        FrameDesc d;
+        d.field = &field; d.width = W; d.height = H;
+        d.params.tile_w = tw; d.params.tile_h = 3; d.params.scale = s; d.params.stream = nt;
+
+        PixelBuffer ref;
+        RenderParams rp = d.params; rp.stream = false;
+        render_field(field, W, H, rp, t, ref);
+
+        const long bp = diff(ref, render_tiled(d, t, 41, 13, pool));
+        const long bt = diff(ref, render_tiled(d, t, 41, 13, task));
+        host.join();
+        if (bp || bt) {
+          std::printf("[TEST] FAIL scale=%.2f tile=%dx3 stream=%d: pool=%ld task=%ld px\n",
+                      s, tw, int(nt), bp, bt);
+          ++fails;
+        }
+      }
+  std::printf("[TEST] render_partition %dx%d: %s\n", W, H, fails ? "FAIL" : "ok");
+  return fails ? 1 : 0;
+}